@@ -43,6 +43,9 @@ DVRClient::DVRClient(void)
 	bCreated          = true;
 	strBackendName    = "DVR";
 	
+	// start before first journal entry
+	iTimersSequence   = 0;
+	
 	// clear containers
 	cTimerTypes.clear();
 	cTimers.clear();
@@ -126,6 +129,15 @@ time_t DVRClient::LastTimersSync(void)
 	return tLastTimersSync;
 }
 
+long long DVRClient::LastTimersSequence(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// return value
+	return iTimersSequence;
+}
+
 time_t DVRClient::LastRecordingsSync(void)
 {
 	// log function call
@@ -219,7 +231,7 @@ PVR_ERROR DVRClient::GetTimers(ADDON_HANDLE handle)
 	for (vector<DVRTimer>::iterator cTimer = cTimers.begin(); cTimer != cTimers.end(); cTimer++)
 	{
 		// pass back appropriate entries
-		if (cTimer->GetState() == PVR_TIMER_STATE_SCHEDULED || cTimer->GetState() == PVR_TIMER_STATE_RECORDING || cTimer->GetState() == PVR_TIMER_STATE_ERROR)
+		if (cTimer->GetState() == PVR_TIMER_STATE_SCHEDULED || cTimer->GetState() == PVR_TIMER_STATE_RECORDING || cTimer->GetState() == PVR_TIMER_STATE_ERROR || cTimer->GetState() == PVR_TIMER_STATE_CONFLICT_NOK)
 		{
 			// create object
 			PVR_TIMER xbmcTimer;
@@ -660,7 +672,7 @@ PVR_ERROR DVRClient::DeleteRecording(const PVR_RECORDING &recording)
 			client->UpdateRecord("Recordings", strRecording, &sqlRecording);
 
 			// convert record to timer
-			DVRRecording xRecording(sqlRecording.GetRecord() + "<strFilePath>" + cRecording->GetFilePath() + "</strFilePath>");
+			DVRRecording xRecording(sqlRecording.GetRecord() + "<strFilePath>" + EscapeSQLValue(cRecording->GetFilePath()) + "</strFilePath>");
 
 			// assign all values
 			*cRecording = xRecording;
@@ -866,7 +878,7 @@ PVR_ERROR DVRClient::SetRecordingPlayCount(const PVR_RECORDING &recording, int c
 			client->UpdateRecord("Recordings", strRecording, &sqlRecording);
 
 			// convert record to timer
-			DVRRecording xRecording(sqlRecording.GetRecord() + "<strFilePath>" + cRecording->GetFilePath() + "</strFilePath>");
+			DVRRecording xRecording(sqlRecording.GetRecord() + "<strFilePath>" + EscapeSQLValue(cRecording->GetFilePath()) + "</strFilePath>");
 
 			// assign all values
 			*cRecording = xRecording;
@@ -920,7 +932,7 @@ PVR_ERROR DVRClient::SetRecordingLastPlayedPosition(const PVR_RECORDING &recordi
 			client->UpdateRecord("Recordings", strRecording, &sqlRecording);
 
 			// convert record to timer
-			DVRRecording xRecording(sqlRecording.GetRecord() + "<strFilePath>" + cRecording->GetFilePath() + "</strFilePath>");
+			DVRRecording xRecording(sqlRecording.GetRecord() + "<strFilePath>" + EscapeSQLValue(cRecording->GetFilePath()) + "</strFilePath>");
 
 			// assign all values
 			*cRecording = xRecording;
@@ -1067,8 +1079,8 @@ void DVRClient::TriggerTimersUpdate(time_t tSync)
 	// lock threads
 	SetLock();
 	
-	// reload sql objects
-	LoadTimers(tSync, false);
+	// apply changes since last sync
+	SyncTimers(tSync);
 
 	// unlock threads
 	SetUnlock();
@@ -1112,14 +1124,15 @@ void DVRClient::LoadTimerTypes(time_t tSync/* = time(NULL) */, bool bNotify /* =
 	// clear container
 	cTimerTypes.clear();
   	  
-	// get sql objects
-	vector<SQLRecord> sqlTimerTypes = client->GetRecords("TimerTypes");
+	// open cursor on table (rows read as they arrive)
+	SQLCursor sqlCursor;
+	client->GetRecords("TimerTypes", sqlCursor);
 	
 	// iterate through timer types and add to dvr cache
-	for (vector<SQLRecord>::iterator sqlTimerType = sqlTimerTypes.begin(); sqlTimerType != sqlTimerTypes.end(); sqlTimerType++)
+	while (sqlCursor.Next())
 	{	
 		// initialize record
-		DVRTimerType cTimerType(sqlTimerType->GetRecord());
+		DVRTimerType cTimerType(sqlCursor.GetRow());
 		
 		// push back to timer types container
 		cTimerTypes.push_back(cTimerType);	
@@ -1144,14 +1157,15 @@ void DVRClient::LoadTimers(time_t tSync/* = time(NULL) */, bool bNotify /* = tru
 	// clear container
 	cTimers.clear();
   	  
-	// get sql objects
-	vector<SQLRecord> sqlTimers = client->GetRecords("Timers");
+	// open cursor on table (rows read as they arrive)
+	SQLCursor sqlCursor;
+	client->GetRecords("Timers", sqlCursor);
 	
 	// iterate through timers and add to dvr cache
-	for (vector<SQLRecord>::iterator sqlTimer = sqlTimers.begin(); sqlTimer != sqlTimers.end(); sqlTimer++)
+	while (sqlCursor.Next())
 	{
 		// initialize record
-		DVRTimer cTimer(sqlTimer->GetRecord());
+		DVRTimer cTimer(sqlCursor.GetRow());
 		
 		// push back to timer types container
 		cTimers.push_back(cTimer);	
@@ -1176,21 +1190,22 @@ void DVRClient::LoadRecordings(time_t tSync/* = time(NULL) */, bool bNotify /* =
 	// clear container
 	cRecordings.clear();
   	  
-	// get sql objects
-	vector<SQLRecord> sqlRecordings = client->GetRecords("Recordings");
+	// open cursor on table (rows read as they arrive)
+	SQLCursor sqlCursor;
+	client->GetRecords("Recordings", sqlCursor);
 	
 	// iterate through recordings and add to dvr cache
-	for (vector<SQLRecord>::iterator sqlRecording = sqlRecordings.begin(); sqlRecording != sqlRecordings.end(); sqlRecording++)
+	while (sqlCursor.Next())
 	{
 		// derive separator
 		string SEPARATOR = ParseFolderSeparator(settings->GetDVRPath()).c_str();
 	
 		// create folder & file path based on current directory
-		string strFolderPath = settings->GetDVRPath() + StringUtils_Join(SEPARATOR.c_str(), ParseSQLValue(sqlRecording->GetRecord(), "<strDirectory>", "").c_str()                                                                       );
-		string strFilePath   = settings->GetDVRPath() + StringUtils_Join(SEPARATOR.c_str(), ParseSQLValue(sqlRecording->GetRecord(), "<strDirectory>", "").c_str(), ParseSQLValue(sqlRecording->GetRecord(), "<strFileName>", "").c_str());
+		string strFolderPath = settings->GetDVRPath() + StringUtils_Join(SEPARATOR.c_str(), sqlCursor.GetRow().GetString("strDirectory").c_str()                                                         );
+		string strFilePath   = settings->GetDVRPath() + StringUtils_Join(SEPARATOR.c_str(), sqlCursor.GetRow().GetString("strDirectory").c_str(), sqlCursor.GetRow().GetString("strFileName").c_str());
 		
 		// initialize record
-		DVRRecording cRecording(sqlRecording->GetRecord() + "<strFilePath>" + strFilePath + "</strFilePath>"); 
+		DVRRecording cRecording(sqlCursor.GetRow().GetRecord() + "<strFilePath>" + EscapeSQLValue(strFilePath) + "</strFilePath>"); 
 		
 		// push back to recording types container
 		cRecordings.push_back(cRecording);	
@@ -1205,4 +1220,67 @@ void DVRClient::LoadRecordings(time_t tSync/* = time(NULL) */, bool bNotify /* =
 	
 	// set last sync to now
 	tLastRecordingsSync = tSync;
+}
+
+/***********************************************************
+ * Sync Data Definitions
+ ***********************************************************/
+void DVRClient::SyncTimers(time_t tSync)
+{
+	// log function call
+	CPPLog();
+	
+	// create containers for sequence and reset
+	long long iSequence = iTimersSequence;
+	bool      bReset    = false;
+	
+	// open cursor on changes (latest change per timer after last sequence)
+	SQLCursor sqlCursor;
+	
+	// keep cache if backend unreachable
+	if (!client->GetChanges("Timers", iTimersSequence, sqlCursor))
+		return;
+	
+	// iterate through changes and apply to dvr cache
+	while (sqlCursor.Next())
+	{
+		// get change row
+		const SQLRow& sqlRow = sqlCursor.GetRow();
+		
+		// move sequence forward
+		iSequence = max(iSequence, sqlRow.GetInt64("iSequence"));
+		
+		// table replaced so reload once done reading
+		if (sqlRow.GetInt("iAction") == SQL_JOURNAL_RESET)
+			bReset = true;
+		
+		// skip rows covered by reload
+		if (bReset)
+			continue;
+		
+		// get key of changed timer
+		unsigned int iClientIndex = (unsigned int)sqlRow.GetInt("strKey");
+		
+		// remove previous copy from dvr cache
+		for (vector<DVRTimer>::iterator cTimer = cTimers.begin(); cTimer != cTimers.end(); cTimer++)
+		{
+			if (cTimer->GetClientIndex() == iClientIndex)
+			{
+				cTimers.erase(cTimer);
+				break;
+			}
+		}
+		
+		// add current copy if timer still exists
+		if (sqlRow.GetInt("iAction") != SQL_JOURNAL_DELETE && !sqlRow.GetString("iClientIndex").empty())
+			cTimers.push_back(DVRTimer(sqlRow));
+	}
+	
+	// reload table after reset
+	if (bReset)
+		LoadTimers(tSync, false);
+	
+	// set last sequence and sync
+	iTimersSequence = iSequence;
+	tLastTimersSync = tSync;
 }
\ No newline at end of file
@@ -54,13 +54,14 @@ class DVRClient
 		
 	/* status and variable api calls */
 	public:
-		long   GetStatus          (void);
-		bool   IsCreated          (void);
-		string GetBackendName     (void);
-		string GetConnectionString(void);
-		time_t LastTimerTypesSync (void);
-		time_t LastTimersSync     (void);
-		time_t LastRecordingsSync (void);
+		long      GetStatus          (void);
+		bool      IsCreated          (void);
+		string    GetBackendName     (void);
+		string    GetConnectionString(void);
+		time_t    LastTimerTypesSync (void);
+		time_t    LastTimersSync     (void);
+		long long LastTimersSequence (void);
+		time_t    LastRecordingsSync (void);
 		
 	/* timer types api calls */
 	public:
@@ -109,15 +110,20 @@ class DVRClient
 		void LoadTimers    (time_t = time(NULL), bool = true);
 		void LoadRecordings(time_t = time(NULL), bool = true);
 		
+	/* sync functions (apply journal changes, reload on reset) */
+	private:
+		void SyncTimers(time_t);
+		
 	/* server variables */
 	private:
-		int    iCurStatus         ;
-		bool   bCreated           ;
-		string strBackendName     ;
-		time_t tLastTimerTypesSync;
-		time_t tLastTimersSync    ;
-		time_t tLastRecordingsSync;
-		mutex  pMutex             ;
+		int       iCurStatus         ;
+		bool      bCreated           ;
+		string    strBackendName     ;
+		time_t    tLastTimerTypesSync;
+		time_t    tLastTimersSync    ;
+		long long iTimersSequence    ;
+		time_t    tLastRecordingsSync;
+		mutex     pMutex             ;
 		
 	/* data variables */
 	private:
@@ -48,14 +48,16 @@ IPTVClient::IPTVClient(void)
 	cChannelGroups.clear(); 
 	cChannelGroupMembers.clear(); 
 	cEpgChannels.clear(); 
-	cEpgEntries.clear(); 
 	
 	// load sql objects
 	LoadChannels();
 	LoadChannelGroups();
 	LoadChannelGroupMembers();
 	LoadEpgChannels();
-	LoadEpgEntries();
+	
+	// set last guide sync to now (entries fetched per channel window)
+	tLastEpgEntriesSync = time(NULL);
+	iEpgEntriesSequence = 0;
 	
 	// log creation of object
 	XBMC->Log(LOG_NOTICE, "C+: %s - Created IPTV client", __FUNCTION__);
@@ -72,7 +74,6 @@ IPTVClient::~IPTVClient(void)
 	cChannelGroups.clear(); 
 	cChannelGroupMembers.clear(); 
 	cEpgChannels.clear(); 
-	cEpgEntries.clear(); 
 }
 
 /***********************************************************
@@ -159,6 +160,15 @@ time_t IPTVClient::LastEpgEntriesSync(void)
 	return tLastEpgEntriesSync;
 }
 
+long long IPTVClient::LastEpgEntriesSequence(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// return value
+	return iEpgEntriesSequence;
+}
+
 /***********************************************************
  * Live Channels API Definitions
  ***********************************************************/
@@ -477,6 +487,11 @@ PVR_ERROR IPTVClient::GetEPGForChannel(ADDON_HANDLE handle, const PVR_CHANNEL &c
 	// log function call
 	CPPLog();
 	
+	// create containers for guide id and shift
+	string strTvgId  ;
+	time_t iTvgShift = 0;
+	bool   bFound    = false;
+	
 	// lock threads
 	SetLock();
 				
@@ -486,65 +501,9 @@ PVR_ERROR IPTVClient::GetEPGForChannel(ADDON_HANDLE handle, const PVR_CHANNEL &c
 		// look for tv guide id
 		if (cChannel->GetUniqueId() == channel.iUniqueId)
 		{
-			// iterate through epg channels to get tvg id or display name
-			for (vector<IPTVEpgChannel>::iterator cEpgChannel = cEpgChannels.begin(); cEpgChannel != cEpgChannels.end(); cEpgChannel++)
-			{
-				// look for tv guide id or display name 
-				if (StringUtils::EqualsNoCase(StringUtils_Trim(cEpgChannel->GetTvgId()  ), StringUtils_Trim(cChannel->GetTvgId()      )) || 
-				    StringUtils::EqualsNoCase(StringUtils_Trim(cEpgChannel->GetTvgName()), StringUtils_Trim(cChannel->GetTvgName()    )) ||
-					StringUtils::EqualsNoCase(StringUtils_Trim(cEpgChannel->GetTvgName()), StringUtils_Trim(cChannel->GetChannelName()))  )
-				{
-					// iterate through EPG and pass back entries
-					for (vector<IPTVEpgEntry>::iterator cEpgEntry = cEpgEntries.begin(); cEpgEntry != cEpgEntries.end(); cEpgEntry++)
-					{
-						// if matches channel guide and in time frame then pass back to kodi
-						if (cEpgEntry->GetTvgId() == cEpgChannel->GetTvgId())
-						{
-							// only pass back those in window
-							if (cEpgEntry->GetEndTime() >= iStart && cEpgEntry->GetStartTime() <= iEnd)
-							{	
-								// create object
-								EPG_TAG xbmcEpgEntry;
-								memset(&xbmcEpgEntry, 0, sizeof(EPG_TAG));
-											
-								xbmcEpgEntry.iUniqueBroadcastId  = cEpgEntry->GetUniqueBroadcastId()                                                                                                       ;
-								xbmcEpgEntry.iUniqueChannelId    = cChannel->GetUniqueId()                                                                                                                 ;
-								xbmcEpgEntry.strTitle            = cEpgEntry->GetTitle()                                                                                                                   ;
-								xbmcEpgEntry.startTime           = cEpgEntry->GetStartTime() + (settings->GetEPGTimeShift() + (settings->GetEPGTSOverride() ? 0 : cChannel->GetTvgShift()))*SECONDS_IN_HOUR;
-								xbmcEpgEntry.endTime             = cEpgEntry->GetEndTime()   + (settings->GetEPGTimeShift() + (settings->GetEPGTSOverride() ? 0 : cChannel->GetTvgShift()))*SECONDS_IN_HOUR;
-								xbmcEpgEntry.strPlotOutline      = cEpgEntry->GetPlotOutline()                                                                                                             ; 
-								xbmcEpgEntry.strPlot             = cEpgEntry->GetPlot()                                                                                                                    ; 
-								xbmcEpgEntry.strOriginalTitle    = cEpgEntry->GetOriginalTitle()                                                                                                           ;
-								xbmcEpgEntry.strCast             = cEpgEntry->GetCast()                                                                                                                    ;
-								xbmcEpgEntry.strDirector         = cEpgEntry->GetDirector()                                                                                                                ;
-								xbmcEpgEntry.strWriter           = cEpgEntry->GetWriter()                                                                                                                  ;
-								xbmcEpgEntry.iYear               = cEpgEntry->GetYear()                                                                                                                    ;
-								xbmcEpgEntry.strIMDBNumber       = cEpgEntry->GetIMDBNumber()                                                                                                              ;
-								xbmcEpgEntry.strIconPath         = cEpgEntry->GetIconPath()                                                                                                                ;
-								xbmcEpgEntry.iGenreType          = cEpgEntry->GetGenreType()                                                                                                               ;
-								xbmcEpgEntry.iGenreSubType       = cEpgEntry->GetGenreSubType()                                                                                                            ;
-								xbmcEpgEntry.strGenreDescription = cEpgEntry->GetGenreDescription()                                                                                                        ;
-								xbmcEpgEntry.firstAired          = cEpgEntry->GetFirstAired()                                                                                                              ;
-								xbmcEpgEntry.iParentalRating     = cEpgEntry->GetParentalRating()                                                                                                          ;
-								xbmcEpgEntry.iStarRating         = cEpgEntry->GetStarRating()                                                                                                              ;
-								xbmcEpgEntry.bNotify             = cEpgEntry->GetNotify()                                                                                                                  ;
-								xbmcEpgEntry.iSeriesNumber       = cEpgEntry->GetSeriesNumber()                                                                                                            ;
-								xbmcEpgEntry.iEpisodeNumber      = cEpgEntry->GetEpisodeNumber()                                                                                                           ;
-								xbmcEpgEntry.iEpisodePartNumber  = cEpgEntry->GetEpisodePartNumber()                                                                                                       ;
-								xbmcEpgEntry.strEpisodeName      = cEpgEntry->GetEpisodeName()                                                                                                             ;
-								xbmcEpgEntry.iFlags              = cEpgEntry->GetFlags()                                                                                                                   ;
-								xbmcEpgEntry.strSeriesLink       = cEpgEntry->GetSeriesLink()                                                                                                              ;
-
-								// pass back to kodi
-								PVR->TransferEpgEntry(handle, &xbmcEpgEntry);
-							}
-						}
-					}
-					
-					// exit loop
-					break;
-				}
-			}
+			// save guide id and shift for query
+			bFound    = FindEpgChannel(*cChannel, strTvgId);
+			iTvgShift = (settings->GetEPGTimeShift() + (settings->GetEPGTSOverride() ? 0 : cChannel->GetTvgShift()))*SECONDS_IN_HOUR;
 					
 			// exit loop
 			break;
@@ -553,6 +512,56 @@ PVR_ERROR IPTVClient::GetEPGForChannel(ADDON_HANDLE handle, const PVR_CHANNEL &c
 	
 	// unlock threads
 	SetUnlock();
+	
+	// nothing to pass back without guide channel
+	if (!bFound)
+		return PVR_ERROR_NO_ERROR;
+	
+	// open cursor on channel window (server only sends entries in window)
+	SQLCursor sqlCursor;
+	client->GetEpgEntries(strTvgId.c_str(), iStart, iEnd, sqlCursor);
+	
+	// iterate through window and pass back entries
+	while (sqlCursor.Next())
+	{
+		// initialize record
+		IPTVEpgEntry cEpgEntry(sqlCursor.GetRow());
+		
+		// create object
+		EPG_TAG xbmcEpgEntry;
+		memset(&xbmcEpgEntry, 0, sizeof(EPG_TAG));
+					
+		xbmcEpgEntry.iUniqueBroadcastId  = cEpgEntry.GetUniqueBroadcastId()    ;
+		xbmcEpgEntry.iUniqueChannelId    = channel.iUniqueId                   ;
+		xbmcEpgEntry.strTitle            = cEpgEntry.GetTitle()                ;
+		xbmcEpgEntry.startTime           = cEpgEntry.GetStartTime() + iTvgShift;
+		xbmcEpgEntry.endTime             = cEpgEntry.GetEndTime()   + iTvgShift;
+		xbmcEpgEntry.strPlotOutline      = cEpgEntry.GetPlotOutline()          ; 
+		xbmcEpgEntry.strPlot             = cEpgEntry.GetPlot()                 ; 
+		xbmcEpgEntry.strOriginalTitle    = cEpgEntry.GetOriginalTitle()        ;
+		xbmcEpgEntry.strCast             = cEpgEntry.GetCast()                 ;
+		xbmcEpgEntry.strDirector         = cEpgEntry.GetDirector()             ;
+		xbmcEpgEntry.strWriter           = cEpgEntry.GetWriter()               ;
+		xbmcEpgEntry.iYear               = cEpgEntry.GetYear()                 ;
+		xbmcEpgEntry.strIMDBNumber       = cEpgEntry.GetIMDBNumber()           ;
+		xbmcEpgEntry.strIconPath         = cEpgEntry.GetIconPath()             ;
+		xbmcEpgEntry.iGenreType          = cEpgEntry.GetGenreType()            ;
+		xbmcEpgEntry.iGenreSubType       = cEpgEntry.GetGenreSubType()         ;
+		xbmcEpgEntry.strGenreDescription = cEpgEntry.GetGenreDescription()     ;
+		xbmcEpgEntry.firstAired          = cEpgEntry.GetFirstAired()           ;
+		xbmcEpgEntry.iParentalRating     = cEpgEntry.GetParentalRating()       ;
+		xbmcEpgEntry.iStarRating         = cEpgEntry.GetStarRating()           ;
+		xbmcEpgEntry.bNotify             = cEpgEntry.GetNotify()               ;
+		xbmcEpgEntry.iSeriesNumber       = cEpgEntry.GetSeriesNumber()         ;
+		xbmcEpgEntry.iEpisodeNumber      = cEpgEntry.GetEpisodeNumber()        ;
+		xbmcEpgEntry.iEpisodePartNumber  = cEpgEntry.GetEpisodePartNumber()    ;
+		xbmcEpgEntry.strEpisodeName      = cEpgEntry.GetEpisodeName()          ;
+		xbmcEpgEntry.iFlags              = cEpgEntry.GetFlags()                ;
+		xbmcEpgEntry.strSeriesLink       = cEpgEntry.GetSeriesLink()           ;
+
+		// pass back to kodi
+		PVR->TransferEpgEntry(handle, &xbmcEpgEntry);
+	}
 
 	// return sucess of query
 	return PVR_ERROR_NO_ERROR;
@@ -650,24 +659,6 @@ int IPTVClient::GetEPGChannelsAmount(void)
 	return size;
 }
 
-int IPTVClient::GetEPGAmount(void)
-{
-	// log function call
-	CPPLog(); 
-	
-	// lock threads
-	SetLock();
-
-	// get size
-	int size = cEpgEntries.size();
-	
-	// unlock threads
-	SetUnlock();
-
-	// return size of vector
-	return size;
-}
-
 /***********************************************************
  * Fetch Copy of Data API Definitions
  ***********************************************************/
@@ -743,24 +734,6 @@ vector<IPTVEpgChannel> IPTVClient::GetEpgChannels(void)
 	return ret;
 }
 
-vector<IPTVEpgEntry> IPTVClient::GetEpgEntries(void)
-{
-	// log function call
-	CPPLog(); 
-	
-	// lock threads
-	SetLock();
-
-	// read current vectors
-	vector<IPTVEpgEntry> ret = cEpgEntries;
-	
-	// unlock threads
-	SetUnlock();
-
-	// return size of vector
-	return ret;
-}
-
 /***********************************************************
  * Trigger Reload API Definitions
  ***********************************************************/
@@ -795,28 +768,24 @@ void IPTVClient::TriggerEpgUpdate(time_t tSync)
 	// log function call
 	CPPLog();	
 	
+	// create container for channels with changed guide
+	vector<unsigned int> iChannels;
+	
 	// lock threads
 	SetLock();
 	
-	// reload sql objects
-	LoadEpgChannels(tSync, false);
-	LoadEpgEntries(tSync, false);
+	// apply changes since last sync (entries fetched per channel window)
+	SyncEpgEntries(tSync, iChannels);
 	
 	// unlock threads
 	SetUnlock();
 	
 	// notify user of reload
-	XBMC->Log(LOG_NOTICE, "C+: %s - %i guide entries loaded", __FUNCTION__, GetEPGAmount());
-	
-	// get channels snapshot
-	vector<IPTVChannel> xChannels = GetChannels();
+	XBMC->Log(LOG_NOTICE, "C+: %s - %i guide channel(s) loaded, %i channel guide(s) changed", __FUNCTION__, GetEPGChannelsAmount(), (int)iChannels.size());
 	
 	// trigger client update
-	for (vector<IPTVChannel>::iterator cChannel = xChannels.begin(); cChannel != xChannels.end(); cChannel++)
-		PVR->TriggerEpgUpdate(cChannel->GetUniqueId());	
-	
-	// clear local container
-	xChannels.clear();
+	for (vector<unsigned int>::iterator iChannel = iChannels.begin(); iChannel != iChannels.end(); iChannel++)
+		PVR->TriggerEpgUpdate(*iChannel);	
 }
 
 /***********************************************************
@@ -830,14 +799,15 @@ void IPTVClient::LoadChannels(time_t tSync/* = time(NULL) */, bool bNotify /* =
 	// clear container
 	cChannels.clear();
   	  
-	// get sql objects
-	vector<SQLRecord> sqlChannels = client->GetRecords("Channels");
+	// open cursor on table (rows read as they arrive)
+	SQLCursor sqlCursor;
+	client->GetRecords("Channels", sqlCursor);
 	
 	// iterate through channels and add to dvr cache
-	for (vector<SQLRecord>::iterator sqlChannel = sqlChannels.begin(); sqlChannel != sqlChannels.end(); sqlChannel++)
+	while (sqlCursor.Next())
 	{	
 		// initialize record
-		IPTVChannel cChannel(sqlChannel->GetRecord());
+		IPTVChannel cChannel(sqlCursor.GetRow());
 		
 		// push back to timer types container
 		cChannels.push_back(cChannel);	
@@ -862,14 +832,15 @@ void IPTVClient::LoadChannelGroups(time_t tSync/* = time(NULL) */, bool bNotify
 	// clear container
 	cChannelGroups.clear();
   	  
-	// get sql objects
-	vector<SQLRecord> sqlChannelGroups = client->GetRecords("ChannelGroups");
+	// open cursor on table (rows read as they arrive)
+	SQLCursor sqlCursor;
+	client->GetRecords("ChannelGroups", sqlCursor);
 	
 	// iterate through channels and add to dvr cache
-	for (vector<SQLRecord>::iterator sqlChannelGroup = sqlChannelGroups.begin(); sqlChannelGroup != sqlChannelGroups.end(); sqlChannelGroup++)
+	while (sqlCursor.Next())
 	{	
 		// initialize record
-		IPTVChannelGroup cChannelGroup(sqlChannelGroup->GetRecord());
+		IPTVChannelGroup cChannelGroup(sqlCursor.GetRow());
 		
 		// push back to timer types container
 		cChannelGroups.push_back(cChannelGroup);	
@@ -894,14 +865,15 @@ void IPTVClient::LoadChannelGroupMembers(time_t tSync/* = time(NULL) */, bool bN
 	// clear container
 	cChannelGroupMembers.clear();
   	  
-	// get sql objects
-	vector<SQLRecord> sqlChannelGroupMembers = client->GetRecords("ChannelGroupMembers");
+	// open cursor on table (rows read as they arrive)
+	SQLCursor sqlCursor;
+	client->GetRecords("ChannelGroupMembers", sqlCursor);
 	
 	// iterate through channels and add to dvr cache
-	for (vector<SQLRecord>::iterator sqlChannelGroupMember = sqlChannelGroupMembers.begin(); sqlChannelGroupMember != sqlChannelGroupMembers.end(); sqlChannelGroupMember++)
+	while (sqlCursor.Next())
 	{	
 		// initialize record
-		IPTVChannelGroupMember cChannelGroupMember(sqlChannelGroupMember->GetRecord());
+		IPTVChannelGroupMember cChannelGroupMember(sqlCursor.GetRow());
 		
 		// push back to timer types container
 		cChannelGroupMembers.push_back(cChannelGroupMember);	
@@ -926,14 +898,15 @@ void IPTVClient::LoadEpgChannels(time_t tSync/* = time(NULL) */, bool bNotify /*
 	// clear container
 	cEpgChannels.clear();
   	  
-	// get sql objects
-	vector<SQLRecord> sqlEpgChannels = client->GetRecords("EpgChannels");
+	// open cursor on table (rows read as they arrive)
+	SQLCursor sqlCursor;
+	client->GetRecords("EpgChannels", sqlCursor);
 	
 	// iterate through epg channels and add to dvr cache
-	for (vector<SQLRecord>::iterator sqlEpgChannel = sqlEpgChannels.begin(); sqlEpgChannel != sqlEpgChannels.end(); sqlEpgChannel++)
+	while (sqlCursor.Next())
 	{	
 		// initialize record
-		IPTVEpgChannel cEpgChannel(sqlEpgChannel->GetRecord());
+		IPTVEpgChannel cEpgChannel(sqlCursor.GetRow());
 		
 		// push back to timer types container
 		cEpgChannels.push_back(cEpgChannel);	
@@ -960,34 +933,96 @@ void IPTVClient::LoadEpgChannels(time_t tSync/* = time(NULL) */, bool bNotify /*
 	tLastEpgChannelsSync = tSync;
 }
 
-void IPTVClient::LoadEpgEntries(time_t tSync/* = time(NULL) */, bool bNotify /* = true */)
+/***********************************************************
+ * Guide Match Definitions
+ ***********************************************************/
+bool IPTVClient::FindEpgChannel(IPTVChannel& cChannel, string& strTvgId)
 {
 	// log function call
 	CPPLog();
 	
-	// clear container
-	cEpgEntries.clear();
-  	  
-	// get sql objects
-	vector<SQLRecord> sqlEpgEntries = client->GetRecords("EpgEntries");
+	// iterate through epg channels to get tvg id or display name
+	for (vector<IPTVEpgChannel>::iterator cEpgChannel = cEpgChannels.begin(); cEpgChannel != cEpgChannels.end(); cEpgChannel++)
+	{
+		// look for tv guide id or display name 
+		if (StringUtils::EqualsNoCase(StringUtils_Trim(cEpgChannel->GetTvgId()  ), StringUtils_Trim(cChannel.GetTvgId()      )) || 
+		    StringUtils::EqualsNoCase(StringUtils_Trim(cEpgChannel->GetTvgName()), StringUtils_Trim(cChannel.GetTvgName()    )) ||
+			StringUtils::EqualsNoCase(StringUtils_Trim(cEpgChannel->GetTvgName()), StringUtils_Trim(cChannel.GetChannelName()))  )
+		{
+			// save guide id
+			strTvgId = cEpgChannel->GetTvgId();
+			
+			// return found
+			return true;
+		}
+	}
 	
-	// iterate through epg and add to dvr cache
-	for (vector<SQLRecord>::iterator sqlEpgEntry = sqlEpgEntries.begin(); sqlEpgEntry != sqlEpgEntries.end(); sqlEpgEntry++)
-	{	
-		// initialize record
-		IPTVEpgEntry cEpgEntry(sqlEpgEntry->GetRecord());
+	// clear guide id
+	strTvgId = "";
+	
+	// return not found
+	return false;
+}
+
+/***********************************************************
+ * Sync Data Definitions
+ ***********************************************************/
+void IPTVClient::SyncEpgEntries(time_t tSync, vector<unsigned int>& iChannels)
+{
+	// log function call
+	CPPLog();
+	
+	// create containers for sequence, reset, and changed guide ids
+	long long             iSequence = iEpgEntriesSequence;
+	bool                  bReset    = false;
+	unordered_set<string> strTvgIds ;
+	
+	// create containers for guide id of each channel before and after reload (guide channels may move)
+	vector<string> strBefore(cChannels.size());
+	string         strAfter ;
+	
+	// open cursor on changes (latest change per guide id after last sequence)
+	SQLCursor sqlCursor;
+	
+	// keep cache if backend unreachable
+	if (!client->GetChanges("EpgEntries", iEpgEntriesSequence, sqlCursor))
+		return;
+	
+	// iterate through changes and collect guide ids
+	while (sqlCursor.Next())
+	{
+		// get change row
+		const SQLRow& sqlRow = sqlCursor.GetRow();
 		
-		// push back to timer types container
-		cEpgEntries.push_back(cEpgEntry);	
+		// move sequence forward
+		iSequence = max(iSequence, sqlRow.GetInt64("iSequence"));
+		
+		// guide replaced so refresh all channels
+		if (sqlRow.GetInt("iAction") == SQL_JOURNAL_RESET)
+			bReset = true;
+		else
+			strTvgIds.insert(sqlRow.GetString("strKey"));
 	}
 	
-	// notify user of epg loaded
-	if (bNotify)
+	// match channels to current guide channels
+	for (size_t i = 0; i < cChannels.size(); i++)
+		FindEpgChannel(cChannels[i], strBefore[i]);
+	
+	// reload guide channels
+	LoadEpgChannels(tSync, false);
+	
+	// collect channels whose guide changed or moved
+	for (size_t i = 0; i < cChannels.size(); i++)
 	{
-		XBMC->QueueNotification(QUEUE_INFO, "%i guide entries loaded", GetEPGAmount());
-		XBMC->Log(LOG_NOTICE, "C+: %s - %i guide entries loaded", __FUNCTION__, GetEPGAmount());
+		// match channel to reloaded guide channels
+		FindEpgChannel(cChannels[i], strAfter);
+		
+		// add channel
+		if (bReset || strAfter != strBefore[i] || (!strAfter.empty() && strTvgIds.count(strAfter)))
+			iChannels.push_back(cChannels[i].GetUniqueId());
 	}
 	
-	// set last sync to now
+	// set last sequence and sync
+	iEpgEntriesSequence = iSequence;
 	tLastEpgEntriesSync = tSync;
 }
\ No newline at end of file
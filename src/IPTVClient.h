@@ -21,6 +21,8 @@
 /***********************************************************
  * Headers
  ***********************************************************/
+#include <unordered_set>
+
 #include "client.h"
 #include "p8-platform/util/util.h"
 
@@ -54,15 +56,16 @@ class IPTVClient
 		
 	/* status and variable api calls */
 	public:
-		long   GetStatus                  (void);
-		bool   IsCreated                  (void);
-		string GetBackendName             (void);
-		string GetConnectionString        (void);
-		time_t LastChannelsSync           (void);
-		time_t LastChannelGroupsSync      (void);
-		time_t LastChannelGroupMembersSync(void);
-		time_t LastEpgChannelsSync        (void);
-		time_t LastEpgEntriesSync         (void);
+		long      GetStatus                  (void);
+		bool      IsCreated                  (void);
+		string    GetBackendName             (void);
+		string    GetConnectionString        (void);
+		time_t    LastChannelsSync           (void);
+		time_t    LastChannelGroupsSync      (void);
+		time_t    LastChannelGroupMembersSync(void);
+		time_t    LastEpgChannelsSync        (void);
+		time_t    LastEpgEntriesSync         (void);
+		long long LastEpgEntriesSequence     (void);
 	
 	/* channels api calls */
 	public:
@@ -90,7 +93,6 @@ class IPTVClient
 		PVR_ERROR IsEPGTagRecordable       (const EPG_TAG*    , bool*                                        );
 		PVR_ERROR GetEPGTagStreamProperties(const EPG_TAG*    ,       PVR_NAMED_VALUE*, unsigned int*        );
 		int       GetEPGChannelsAmount     (void                                                             );
-		int       GetEPGAmount             (void                                                             );
 				
 	/* fetch data api calls */
 	public:
@@ -98,7 +100,6 @@ class IPTVClient
 		vector<IPTVChannelGroup      > GetChannelGroups      (void);
 		vector<IPTVChannelGroupMember> GetChannelGroupMembers(void);
 		vector<IPTVEpgChannel        > GetEpgChannels        (void);
-		vector<IPTVEpgEntry          > GetEpgEntries         (void);
 		
 	/* trigger reload api calls */
 	public:
@@ -111,19 +112,27 @@ class IPTVClient
 		void LoadChannelGroups      (time_t = time(NULL), bool = true);
 		void LoadChannelGroupMembers(time_t = time(NULL), bool = true);
 		void LoadEpgChannels        (time_t = time(NULL), bool = true);
-		void LoadEpgEntries         (time_t = time(NULL), bool = true);		
+		
+	/* guide match functions (caller holds lock) */
+	private:
+		bool FindEpgChannel(IPTVChannel&, string&);
+		
+	/* sync functions (apply journal changes, reload on reset) */
+	private:
+		void SyncEpgEntries(time_t, vector<unsigned int>&);
 		
 	/* client variables */
 	private:
-		int    iCurStatus                  ;
-		bool   bCreated                    ;
-		string strBackendName              ;
-		time_t tLastChannelsSync           ;
-		time_t tLastChannelGroupsSync      ;
-		time_t tLastChannelGroupMembersSync;
-		time_t tLastEpgChannelsSync        ;
-		time_t tLastEpgEntriesSync         ;
-		mutex  pMutex                      ;
+		int       iCurStatus                  ;
+		bool      bCreated                    ;
+		string    strBackendName              ;
+		time_t    tLastChannelsSync           ;
+		time_t    tLastChannelGroupsSync      ;
+		time_t    tLastChannelGroupMembersSync;
+		time_t    tLastEpgChannelsSync        ;
+		time_t    tLastEpgEntriesSync         ;
+		long long iEpgEntriesSequence         ;
+		mutex     pMutex                      ;
 		
 	/* data variables */
 	private:
@@ -131,5 +140,4 @@ class IPTVClient
 		vector<IPTVChannelGroup      > cChannelGroups      ;
 		vector<IPTVChannelGroupMember> cChannelGroupMembers;
 		vector<IPTVEpgChannel        > cEpgChannels        ;
-		vector<IPTVEpgEntry          > cEpgEntries         ;
 };
\ No newline at end of file
@@ -287,6 +287,11 @@ void *PVRRecorder::Process(void)
 	time_t recordingTime = 0;
 	time_t lastRead      = 0;
 	
+	// get true start (launched ahead by pre-roll, data before it trimmed if container splits on packets, otherwise kept as margin)
+	time_t trimTime      = timer.startTime - timer.iMarginStart*60;
+	bool   bTrim         = (trimTime > time(NULL) && settings->GetFileExt() == FFMPEG_TRIM_FORMAT);
+	size_t trimBytes     = 0;
+	
 	// open recording file for write
 	fileHandle = XBMC->OpenFileForWrite(strFilePath.c_str(), true);
 	
@@ -318,8 +323,24 @@ void *PVRRecorder::Process(void)
 				//if read proceed to write to file
 				if (ffmpeg.gcount() > 0)
 				{
+					// create offset of data to write
+					int iOffset = 0;
+					
+					// discard pre-roll before true start, then up to the next packet boundary
+					if (bTrim)
+					{
+						iOffset    = (trimTime > time(NULL)) ? ffmpeg.gcount() : min(ffmpeg.gcount(), (int)((FFMPEG_TRIM_PACKET - trimBytes % FFMPEG_TRIM_PACKET) % FFMPEG_TRIM_PACKET));
+						trimBytes += iOffset;
+						bTrim      = (trimTime > time(NULL) || trimBytes % FFMPEG_TRIM_PACKET != 0);
+						
+						// log end of pre-roll
+						if (!bTrim)
+							XBMC->Log(LOG_NOTICE, "C+: %s - Trimmed %i bytes of pre-roll from %s recording", __FUNCTION__, (int)trimBytes, cTimer.GetTitle());
+					}
+					
 					// write to file
-					XBMC->WriteFile(fileHandle, readBuffer, ffmpeg.gcount());
+					if (ffmpeg.gcount() > iOffset)
+						XBMC->WriteFile(fileHandle, readBuffer + iOffset, ffmpeg.gcount() - iOffset);
 
 					// mark time of read
 					lastRead = time(NULL);
@@ -351,11 +372,8 @@ void *PVRRecorder::Process(void)
 			// check for termination of recording
 			if (timer.state == PVR_TIMER_STATE_COMPLETED || timer.state == PVR_TIMER_STATE_ABORTED)
 			{
-				// mark completion on timer
-				timer.state = PVR_TIMER_STATE_COMPLETED;
-
-				// log failure due to timeout
-				XBMC->Log(LOG_NOTICE, "C+: %s - Completed %s recording [%s]", __FUNCTION__, cTimer.GetTitle(), strFileName.c_str());
+				// log completion (state kept, aborted if deleted or preempted)
+				XBMC->Log(LOG_NOTICE, "C+: %s - %s %s recording [%s]", __FUNCTION__, timer.state == PVR_TIMER_STATE_ABORTED ? "Aborted" : "Completed", cTimer.GetTitle(), strFileName.c_str());
 
 				// exit loop
 				break;      
@@ -390,11 +408,8 @@ void *PVRRecorder::Process(void)
 	if (timer.state == PVR_TIMER_STATE_RECORDING)
 		timer.state = PVR_TIMER_STATE_COMPLETED;
 	
-	// create update string
-	string strTimer = " SET state = " + itos(timer.state) + " WHERE iClientIndex = " + itos(timer.iClientIndex) + ";";
-	
 	// update in database
-	sqlite->UpdateRecord("Timers", strTimer);
+	sqlite->UpdateRecord("Timers", " SET state = ? WHERE iClientIndex = ?", {(int)timer.state, timer.iClientIndex});
 	  
 	// sleep allow pipe to clear out
 	sleep(1);
@@ -22,7 +22,11 @@
  * Headers
  ***********************************************************/
 #include <string>
+#include <vector>
 #include <ctime>
+#include <map>
+#include <mutex>
+#include <condition_variable>
 
 /***********************************************************
  * Namespace Definitions
@@ -32,18 +36,43 @@ using namespace std;
 /***********************************************************
  * Server Connect Constants
  ***********************************************************/
- 
+#define SERVER_BUFFER_SIZE 65536
+
 /***********************************************************
  * Database Constants
  ***********************************************************/
 #define DATABASE_FOLDER  "database"
 #define DATABASE_FILE    "DVR.db"
+#define DATABASE_READERS 4
+#define DATABASE_TIMEOUT 5000
+#define DATABASE_STAGING "Staging"
+#define DATABASE_JOURNAL 7
+
+/***********************************************************
+ * Source Cache Constants
+ ***********************************************************/
+#define SOURCE_CACHE_FOLDER "cache"
+#define SOURCE_READ_SIZE    65536
+
+/***********************************************************
+ * Playlist Import Constants
+ ***********************************************************/
+#define M3U_INSERT_BATCH 1024
+
+/***********************************************************
+ * Guide Import Constants
+ ***********************************************************/
+#define XMLTV_DECODE_BATCH   4096
+#define XMLTV_DECODE_THREADS 8
+#define XMLTV_DECODE_CHUNK   64
 
 /***********************************************************
  * FFMPEG Constants
  ***********************************************************/
-#define FFMPEG_LOG_FOLDER "log"
-#define FFMPEG_LOG_FILE   "ffmpeg.log"
+#define FFMPEG_LOG_FOLDER  "log"
+#define FFMPEG_LOG_FILE    "ffmpeg.log"
+#define FFMPEG_TRIM_FORMAT "mpegts"
+#define FFMPEG_TRIM_PACKET 188
 
 /***********************************************************
  * Variable Type Lengths
@@ -97,19 +126,115 @@ typedef enum
   LOGO_PREFERENCE_XMLTV   = 2, /*!< @brief prefer xmltv logo */
 } LOGO_PREFERENCE;
 
+/***********************************************************
+ * SQL Bound Values
+ ***********************************************************/
+typedef enum
+{
+  SQL_VALUE_INT   = 0, /*!< @brief bind as integer */
+  SQL_VALUE_FLOAT = 1, /*!< @brief bind as float */
+  SQL_VALUE_TEXT  = 2, /*!< @brief bind as text */
+} SQL_VALUE_TYPE;
+
+struct SQLValue{
+		SQLValue(const int          iData  ) : iType(SQL_VALUE_INT  ), iValue(iData), fValue(0.0  ), strValue(""                   ) {}
+		SQLValue(const unsigned int iData  ) : iType(SQL_VALUE_INT  ), iValue(iData), fValue(0.0  ), strValue(""                   ) {}
+		SQLValue(const long         iData  ) : iType(SQL_VALUE_INT  ), iValue(iData), fValue(0.0  ), strValue(""                   ) {}
+		SQLValue(const long long    iData  ) : iType(SQL_VALUE_INT  ), iValue(iData), fValue(0.0  ), strValue(""                   ) {}
+		SQLValue(const double       fData  ) : iType(SQL_VALUE_FLOAT), iValue(0    ), fValue(fData), strValue(""                   ) {}
+		SQLValue(const bool         bData  ) : iType(SQL_VALUE_TEXT ), iValue(0    ), fValue(0.0  ), strValue(bData ? "true" : "false") {}
+		SQLValue(const char*        strData) : iType(SQL_VALUE_TEXT ), iValue(0    ), fValue(0.0  ), strValue(strData ? strData : "") {}
+		SQLValue(const string&      strData) : iType(SQL_VALUE_TEXT ), iValue(0    ), fValue(0.0  ), strValue(strData              ) {}
+		
+		SQL_VALUE_TYPE iType   ;
+		long long      iValue  ;
+		double         fValue  ;
+		string         strValue;
+};
+
+/***********************************************************
+ * SQL Decoded Guide Entries
+ ***********************************************************/
+struct SQLEpgRow{
+		bool             bIsValid ;
+		string           strTvgId ;
+		string           strTitle ;
+		time_t           startTime;
+		time_t           endTime  ;
+		vector<SQLValue> sqlValues;
+};
+
+/***********************************************************
+ * SQL Guide Decode Queue
+ ***********************************************************/
+struct SQLDecodeQueue{
+		mutex                  pMutex     ;
+		condition_variable     cWork      ;
+		condition_variable     cDone      ;
+		const vector<string>  *strElements;
+		vector<SQLEpgRow>     *sqlEntries ;
+		size_t                 iNext      ;
+		size_t                 iPending   ;
+		bool                   bStop      ;
+};
+
+/***********************************************************
+ * SQL Timer Deadlines
+ ***********************************************************/
+struct SQLDeadline{
+		bool operator>(const SQLDeadline& sqlDeadline) const {return tDeadline > sqlDeadline.tDeadline || (tDeadline == sqlDeadline.tDeadline && iPriority < sqlDeadline.iPriority);}
+		
+		time_t tDeadline;
+		int    iPriority;
+		int    iTimer   ;
+};
+
+/***********************************************************
+ * SQL Source Cache
+ ***********************************************************/
+struct SQLSource{
+		string strUrl         ;
+		string strSalt        ;
+		string strHash        ;
+		string strETag        ;
+		string strLastModified;
+};
+
+/***********************************************************
+ * SQL Change Journal
+ ***********************************************************/
+typedef enum
+{
+  SQL_JOURNAL_INSERT = 0, /*!< @brief row added */
+  SQL_JOURNAL_UPDATE = 1, /*!< @brief row changed */
+  SQL_JOURNAL_DELETE = 2, /*!< @brief row removed */
+  SQL_JOURNAL_RESET  = 3, /*!< @brief table replaced, reload all rows */
+} SQL_JOURNAL_ACTION;
+
 /***********************************************************
  * SQL Process
  ***********************************************************/
 struct SQLMsg{
-		string strTable;
-		time_t iModTime;
+		string    strTable ;
+		string    strKey   ;
+		time_t    iModTime ;
+		long long iSequence;
 };
 
 class PVRRecorder;
+struct sqlite3;
+struct sqlite3_stmt;
 
 struct SQLTask{
 		unsigned int iClientIndex     ;
 		int          iClientChannelUid;
 		unsigned int iEpgUid          ;
+		string       strSource        ;
 		PVRRecorder* pProcess         ;
+};
+
+struct SQLReader{
+		sqlite3*                   sqlDatabase  ;
+		map<string, sqlite3_stmt*> sqlStatements;
+		mutex                      pMutex       ;
 };
\ No newline at end of file
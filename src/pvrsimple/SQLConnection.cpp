@@ -39,15 +39,22 @@ SQLConnection::SQLConnection()
 		// log attempt to create object
 		XBMC->Log(LOG_NOTICE, "C+: %s - Creating SQL connection", __FUNCTION__);
 		
-		// no establish connection at start
+		// no establish connection at start (playlist and guide load once thread runs)
 		bIsConnected = false;
 		bIsWorking   = false;
+		bIsLoading   = true ;
 		bStop        = false;
 		
+		// load timers and expand timer rules on first pass of scheduler
+		bScheduleChanged = true;
+		iExpandSequence  = -1;
+		strExpandKeys.clear();
+		
 		// clear inervals
-		tLastM3URead = 0;
-		tLastEPGRead = 0;
-		iNumEPGDays  = 0;
+		tLastM3URead  = 0;
+		tLastEPGRead  = 0;
+		tLastEPGClean = 0;
+		iNumEPGDays   = 0;
 		
 		// add folder name to directory
 		strDBPath += settings->GetUserPath() + DATABASE_FOLDER + ParseFolderSeparator(settings->GetUserPath());
@@ -59,22 +66,24 @@ SQLConnection::SQLConnection()
 		// add file name to directory
 		strDBPath += DATABASE_FILE;
 		
-		// clear callback buffer, logs, and tasks
+		// clear callback buffer, logs, tasks, and readers
 		sqlCallback.clear();
 		sqlLog.clear();
 		sqlTasks.clear();
+		sqlReaders.clear();
+		iNextRead = 0;
 		
-		// create change log
+		// create change log (key column set for tables journaled per row, guide entries journal changed tvg ids, others only journal swaps)
 		SQLMsg sqlMsg;
 		
-		sqlMsg.strTable = "Channels"           ; sqlMsg.iModTime = 0; sqlLog.push_back(sqlMsg);
-		sqlMsg.strTable = "ChannelGroups"      ; sqlMsg.iModTime = 0; sqlLog.push_back(sqlMsg);
-		sqlMsg.strTable = "ChannelGroupMembers"; sqlMsg.iModTime = 0; sqlLog.push_back(sqlMsg);
-		sqlMsg.strTable = "EpgChannels"        ; sqlMsg.iModTime = 0; sqlLog.push_back(sqlMsg);
-		sqlMsg.strTable = "EpgEntries"         ; sqlMsg.iModTime = 0; sqlLog.push_back(sqlMsg);
-		sqlMsg.strTable = "TimerTypes"         ; sqlMsg.iModTime = 0; sqlLog.push_back(sqlMsg);
-		sqlMsg.strTable = "Timers"             ; sqlMsg.iModTime = 0; sqlLog.push_back(sqlMsg);
-		sqlMsg.strTable = "Recordings"         ; sqlMsg.iModTime = 0; sqlLog.push_back(sqlMsg);
+		sqlMsg.strTable = "Channels"           ; sqlMsg.strKey = "iUniqueId"     ; sqlMsg.iModTime = 0; sqlMsg.iSequence = 0; sqlLog.push_back(sqlMsg);
+		sqlMsg.strTable = "ChannelGroups"      ; sqlMsg.strKey = ""              ; sqlMsg.iModTime = 0; sqlMsg.iSequence = 0; sqlLog.push_back(sqlMsg);
+		sqlMsg.strTable = "ChannelGroupMembers"; sqlMsg.strKey = ""              ; sqlMsg.iModTime = 0; sqlMsg.iSequence = 0; sqlLog.push_back(sqlMsg);
+		sqlMsg.strTable = "EpgChannels"        ; sqlMsg.strKey = ""              ; sqlMsg.iModTime = 0; sqlMsg.iSequence = 0; sqlLog.push_back(sqlMsg);
+		sqlMsg.strTable = "EpgEntries"         ; sqlMsg.strKey = ""              ; sqlMsg.iModTime = 0; sqlMsg.iSequence = 0; sqlLog.push_back(sqlMsg);
+		sqlMsg.strTable = "TimerTypes"         ; sqlMsg.strKey = "iId"           ; sqlMsg.iModTime = 0; sqlMsg.iSequence = 0; sqlLog.push_back(sqlMsg);
+		sqlMsg.strTable = "Timers"             ; sqlMsg.strKey = "iClientIndex"  ; sqlMsg.iModTime = 0; sqlMsg.iSequence = 0; sqlLog.push_back(sqlMsg);
+		sqlMsg.strTable = "Recordings"         ; sqlMsg.strKey = "strRecordingId"; sqlMsg.iModTime = 0; sqlMsg.iSequence = 0; sqlLog.push_back(sqlMsg);
 			
 		// call connection to database
 		Connect();
@@ -87,24 +96,21 @@ SQLConnection::SQLConnection()
 				bStop = true;
 		}
 		
-		// call clear/clean functions
-		ClearChannels();
-		ClearChannelGroups();
-		ClearChannelGroupMembers();
-		ClearGuideChannels();
-		ClearGuideEntries();
+		// bring existing databases up to current schema
+		if (!MigrateSchema())
+			bStop = true;
+		
+		// switch to write ahead log and open readers (after empty check as wal writes the header)
+		OpenReaders();
+		
+		// call clear/clean functions (channels and guide are refreshed by import)
 		ClearTimerTypes();
 		CleanTimers();
 		CleanRecordings();
 		
-		// import external files
-		ImportM3U();
-		ImportXMLTV();
+		// import timer types (playlist and guide import on thread, clients read last persisted tables meanwhile)
 		ImportTimerTypes();
 		
-		// apply filters
-		FilterChannelsEPG();
-		
 		// log creation of object
 		XBMC->Log(LOG_NOTICE, "C+: %s - Created SQL connection", __FUNCTION__);
 		
@@ -118,8 +124,9 @@ SQLConnection::~SQLConnection(void)
 	// only server mode
 	if (settings->GetDVRMode() == SERVER_MODE)
 	{
-		// mark as stopped
+		// mark as stopped (wake scheduler so it sees stop)
 		bStop = true;
+		WakeSchedule();
 			
 		// clear callback buffer, logs, and tasks
 		sqlCallback.clear();
@@ -156,6 +163,15 @@ bool SQLConnection::IsWorking(void)
 	return bIsWorking;
 }
 
+bool SQLConnection::IsLoading(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// return value
+	return bIsLoading;
+}
+
 time_t SQLConnection::LastM3URead(void)
 {
 	// log function call
@@ -191,9 +207,36 @@ string SQLConnection::GetDBLog(void)
 	// create return string
 	string strLog;
 	
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
+	
+	// fetch compiled query for last journal sequence of each table
+	sqlite3_stmt *sqlQuery = PrepareQuery("SELECT MAX(iSequence) FROM Journal WHERE strTable = ?", sqlReader);
+	
 	// iterate through log
 	for (vector<SQLMsg>::iterator sqlMsg = sqlLog.begin(); sqlMsg != sqlLog.end(); sqlMsg++)
-		strLog += "<strTable>"+sqlMsg->strTable+"</strTable>"+"<iModTime>"+itos(sqlMsg->iModTime)+"</iModTime>"+"\n";
+	{
+		// bind table and read sequence directly
+		if (sqlQuery)
+		{
+			BindQuery(sqlQuery, {sqlMsg->strTable});
+			
+			if (sqlite3_step(sqlQuery) == SQLITE_ROW)
+				sqlMsg->iSequence = sqlite3_column_int64(sqlQuery, 0);
+			
+			// release statement
+			sqlite3_reset(sqlQuery);
+		}
+		
+		// add message to log
+		strLog += "<strTable>"+sqlMsg->strTable+"</strTable>"+"<iModTime>"+itos(sqlMsg->iModTime)+"</iModTime>"+"<iSequence>"+to_string(sqlMsg->iSequence)+"</iSequence>"+"\n";
+	}
+	
+	// add backend state to log (clients show loading until startup import completes)
+	strLog += "<strTable>Backend</strTable><bIsLoading>"+btos(IsLoading())+"</bIsLoading>\n";
+	
+	// unlock reader connection
+	UnlockReader(sqlReader);
 	
 	// delete last 2 characters (extra line break)
 	strLog = strLog.substr(1, strLog.length()-2);
@@ -229,14 +272,69 @@ void SQLConnection::AddRecord(const char* strTable, const string strRecord, SQLR
 				*sqlRecord = sqlReturn.front();
 			
 	// update change log
-	for (vector<SQLMsg>::iterator sqlMsg = sqlLog.begin(); sqlMsg != sqlLog.end(); sqlMsg++)
-		if (string(strTable) == sqlMsg->strTable)
-			sqlMsg->iModTime = time(NULL);
+	UpdateDBLog(strTable);
 			
 	// unlock threads
 	SetUnlock();
 }
 
+void SQLConnection::AddRecord(const char* strTable, const string strRecord, const vector<SQLValue>& sqlValues)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock threads
+	SetLock();
+	
+	// fetch compiled query for table and columns
+	sqlite3_stmt *sqlQuery = PrepareQuery(string("INSERT INTO ") + string(strTable) + string(strRecord));
+	
+	// bind values and call query
+	if (sqlQuery)
+	{
+		BindQuery(sqlQuery, sqlValues);
+		StepQuery(sqlQuery, NULL);
+	}
+	
+	// update change log
+	UpdateDBLog(strTable);
+	
+	// unlock threads
+	SetUnlock();
+}
+
+void SQLConnection::AddRecords(const char* strTable, const string strRecord, const vector<vector<SQLValue> >& sqlRows)
+{
+	// log function call
+	CPPLog(); 
+	
+	// skip if nothing to add
+	if (sqlRows.empty())
+		return;
+	
+	// start transaction (lock and commit once for whole batch)
+	BeginTransaction();
+	
+	// fetch compiled query for table and columns
+	sqlite3_stmt *sqlQuery = PrepareQuery(string("INSERT INTO ") + string(strTable) + string(strRecord));
+	
+	// bind values and call query per row (step resets query for next row)
+	if (sqlQuery)
+	{
+		for (vector<vector<SQLValue> >::const_iterator sqlValues = sqlRows.begin(); sqlValues != sqlRows.end(); sqlValues++)
+		{
+			BindQuery(sqlQuery, *sqlValues);
+			StepQuery(sqlQuery, NULL);
+		}
+	}
+	
+	// update change log
+	UpdateDBLog(strTable);
+	
+	// end transaction
+	EndTransaction();
+}
+
 void SQLConnection::UpdateRecord(const char* strTable, const string strRecord, SQLRecord* sqlRecord)
 {
 	// log function call
@@ -261,14 +359,37 @@ void SQLConnection::UpdateRecord(const char* strTable, const string strRecord, S
 				*sqlRecord = sqlReturn.front();
 				
 	// update change log
-	for (vector<SQLMsg>::iterator sqlMsg = sqlLog.begin(); sqlMsg != sqlLog.end(); sqlMsg++)
-		if (string(strTable) == sqlMsg->strTable)
-			sqlMsg->iModTime = time(NULL);
+	UpdateDBLog(strTable);
 			
 	// unlock threads
 	SetUnlock();
 }
 
+void SQLConnection::UpdateRecord(const char* strTable, const string strRecord, const vector<SQLValue>& sqlValues)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock threads
+	SetLock();
+	
+	// fetch compiled query for table and clause
+	sqlite3_stmt *sqlQuery = PrepareQuery(string("UPDATE ") + string(strTable) + string(strRecord));
+	
+	// bind values and call query
+	if (sqlQuery)
+	{
+		BindQuery(sqlQuery, sqlValues);
+		StepQuery(sqlQuery, NULL);
+	}
+	
+	// update change log
+	UpdateDBLog(strTable);
+	
+	// unlock threads
+	SetUnlock();
+}
+
 void SQLConnection::DeleteRecord(const char* strTable, const string strRecord)
 {
 	// log function call
@@ -284,9 +405,7 @@ void SQLConnection::DeleteRecord(const char* strTable, const string strRecord)
 	SendQuery(sqlDeleteRecord.c_str(), NULL);
 	
 	// update change log
-	for (vector<SQLMsg>::iterator sqlMsg = sqlLog.begin(); sqlMsg != sqlLog.end(); sqlMsg++)
-		if (string(strTable) == sqlMsg->strTable)
-			sqlMsg->iModTime = time(NULL);
+	UpdateDBLog(strTable);
 	
 	// unlock threads
 	SetUnlock();
@@ -297,8 +416,8 @@ bool SQLConnection::FindRecord(const char* strTable, const char* iId, const int
 	// log function call
 	CPPLog();
 
-	// lock threads
-	SetLock();	
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
 		
 	// create return vector
 	vector<SQLRecord> sqlReturn;
@@ -306,16 +425,21 @@ bool SQLConnection::FindRecord(const char* strTable, const char* iId, const int
 	// clear vector
 	sqlReturn.clear();
 	
-	// create query and sql text
-	string sqlFindRecordBy = string("SELECT * FROM ") + string(strTable) + string(" WHERE ") + string(iId) + string(" = ") + StringUtils_Replace(itos(iValue), "'", "''") + string("");
+	// fetch compiled query for table and column
+	sqlite3_stmt *sqlQuery = PrepareQuery(string("SELECT * FROM ") + string(strTable) + string(" WHERE ") + string(iId) + string(" = ?"), sqlReader);
 	
-	// call query
-	if (SendQuery(sqlFindRecordBy.c_str(), &sqlReturn) == SQLITE_OK)
-		if (sqlReturn.size())
-			sqlRecord = sqlReturn.front();
+	// bind value and call query
+	if (sqlQuery)
+	{
+		BindQuery(sqlQuery, {iValue});
+		
+		if (StepQuery(sqlQuery, &sqlReturn) == SQLITE_OK)
+			if (sqlReturn.size())
+				sqlRecord = sqlReturn.front();
+	}
 
-	// unlock threads
-	SetUnlock();
+	// unlock reader connection
+	UnlockReader(sqlReader);
 	
 	// return record
 	return (sqlReturn.size() > 0);	
@@ -326,8 +450,8 @@ bool SQLConnection::FindRecord(const char* strTable, const char* strId, const ch
 	// log function call
 	CPPLog();
 
-	// lock threads
-	SetLock();	
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
 	
 	// create return vector
 	vector<SQLRecord> sqlReturn;
@@ -335,16 +459,21 @@ bool SQLConnection::FindRecord(const char* strTable, const char* strId, const ch
 	// clear vector
 	sqlReturn.clear();
 	
-	// create query and sql text
-	string sqlFindRecordBy = string("SELECT * FROM ") + string(strTable) + string(" WHERE ") + string(strId) + string(" = '") + StringUtils_Replace(string(strValue), "'", "''") + string("'");
+	// fetch compiled query for table and column
+	sqlite3_stmt *sqlQuery = PrepareQuery(string("SELECT * FROM ") + string(strTable) + string(" WHERE ") + string(strId) + string(" = ?"), sqlReader);
 	
-	// call query
-	if (SendQuery(sqlFindRecordBy.c_str(), &sqlReturn) == SQLITE_OK)
-		if (sqlReturn.size())
-			sqlRecord = sqlReturn.front();
+	// bind value and call query
+	if (sqlQuery)
+	{
+		BindQuery(sqlQuery, {strValue});
 		
-	// unlock threads
-	SetUnlock();
+		if (StepQuery(sqlQuery, &sqlReturn) == SQLITE_OK)
+			if (sqlReturn.size())
+				sqlRecord = sqlReturn.front();
+	}
+		
+	// unlock reader connection
+	UnlockReader(sqlReader);
 	
 	// return record
 	return (sqlReturn.size() > 0);	
@@ -355,8 +484,8 @@ bool SQLConnection::FindRecord(const char* strTable, const string strWhere, SQLR
 	// log function call
 	CPPLog();
 
-	// lock threads
-	SetLock();	
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
 	
 	// create return vector
 	vector<SQLRecord> sqlReturn;
@@ -367,13 +496,20 @@ bool SQLConnection::FindRecord(const char* strTable, const string strWhere, SQLR
 	// create query and sql text
 	string sqlFindRecordBy = string("SELECT * FROM ") + string(strTable) + string(" WHERE ") + string(strWhere) + string("");
 	
+	// create container for compiled query (where clause varies so not cached)
+	sqlite3_stmt *sqlQuery = NULL;
+	
 	// call query
-	if (SendQuery(sqlFindRecordBy.c_str(), &sqlReturn) == SQLITE_OK)
-		if (sqlReturn.size())
-			sqlRecord = sqlReturn.front();
+	if (sqlite3_prepare_v2(sqlReader ? sqlReader->sqlDatabase : sqlDatabase, sqlFindRecordBy.c_str(), -1, &sqlQuery, NULL) == SQLITE_OK)
+		if (StepQuery(sqlQuery, &sqlReturn) == SQLITE_OK)
+			if (sqlReturn.size())
+				sqlRecord = sqlReturn.front();
+	
+	// release query
+	sqlite3_finalize(sqlQuery);
 		
-	// unlock threads
-	SetUnlock();
+	// unlock reader connection
+	UnlockReader(sqlReader);
 	
 	// return record
 	return (sqlReturn.size() > 0);	
@@ -384,28 +520,27 @@ int SQLConnection::GetTableSize(const char* strTable)
 	// log function call
 	CPPLog(); 
 	
-	// lock threads
-	SetLock();
-	
-	// create return vector
-	vector<SQLRecord> sqlReturn;
-	
-	// clear vector
-	sqlReturn.clear();
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
 	
 	// create return value
 	int iReturn =  -1;
 	
-	// create query and sql text
-	string sqlGetSize  = string("SELECT COUNT(*) FROM ") + string(strTable);
+	// fetch compiled query for table
+	sqlite3_stmt *sqlQuery = PrepareQuery(string("SELECT COUNT(*) FROM ") + string(strTable), sqlReader);
 	
-	// call query
-	if (SendQuery(sqlGetSize.c_str(), &sqlReturn) == SQLITE_OK)
-		if (sqlReturn.size())
-			iReturn = stoi(ParseSQLValue(sqlReturn.front().GetRecord(), "<COUNT(*)>", ""));
+	// call query and read count directly
+	if (sqlQuery)
+	{
+		if (sqlite3_step(sqlQuery) == SQLITE_ROW)
+			iReturn = sqlite3_column_int(sqlQuery, 0);
 		
-	// unlock threads
-	SetUnlock();
+		// release statement
+		sqlite3_reset(sqlQuery);
+	}
+		
+	// unlock reader connection
+	UnlockReader(sqlReader);
 	
 	// return size
 	return iReturn;	
@@ -414,32 +549,207 @@ int SQLConnection::GetTableSize(const char* strTable)
 /***********************************************************
  * Tables API Definitions
  ***********************************************************/
-vector<SQLRecord> SQLConnection::GetRecords(const char* strTable)
+bool SQLConnection::GetRecords(const char* strTable, SQLCursor& sqlCursor)
 {
 	// log function call
 	CPPLog(); 
 	
-	// lock threads
-	SetLock();
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
 	
-	// create return vector
-	vector<SQLRecord> sqlReturn;
+	// fetch compiled query for table
+	sqlite3_stmt *sqlQuery = PrepareQuery(string("SELECT * FROM ") + string(strTable), sqlReader);
+	
+	// unlock reader connection if nothing to step
+	if (!sqlQuery)
+	{
+		UnlockReader(sqlReader);
+		return false;
+	}
+	
+	// hand statement and lock to cursor (released after last row)
+	sqlCursor.Open(sqlQuery, sqlReader ? &sqlReader->pMutex : &pMutex);
+	
+	// read rows up front when on writer (writer never held while rows are sent)
+	if (!sqlReader)
+		sqlCursor.Buffer();
+	
+	// return status
+	return true;
+}
+
+/***********************************************************
+ * Guide API Definitions
+ ***********************************************************/
+bool SQLConnection::GetEpgEntries(const char* strTvgId, const time_t iStart, const time_t iEnd, SQLCursor& sqlCursor)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
+	
+	// fetch compiled query for window (served by tvg id and start time index)
+	sqlite3_stmt *sqlQuery = PrepareQuery("SELECT * FROM EpgEntries WHERE strTvgId = ? AND startTime <= ? AND endTime >= ? ORDER BY startTime", sqlReader);
+	
+	// unlock reader connection if nothing to step
+	if (!sqlQuery)
+	{
+		UnlockReader(sqlReader);
+		return false;
+	}
+	
+	// bind channel and window
+	BindQuery(sqlQuery, {strTvgId, iEnd, iStart});
+	
+	// hand statement and lock to cursor (released after last row)
+	sqlCursor.Open(sqlQuery, sqlReader ? &sqlReader->pMutex : &pMutex);
+	
+	// read rows up front when on writer (writer never held while rows are sent)
+	if (!sqlReader)
+		sqlCursor.Buffer();
+	
+	// return status
+	return true;
+}
+
+bool SQLConnection::GetEpgEntries(const char* strTvgId, const char* strColumn, const string strValue, const time_t iEnd, SQLCursor& sqlCursor)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
+	
+	// fetch compiled query for column (served by tvg id and column index)
+	sqlite3_stmt *sqlQuery = PrepareQuery(string("SELECT * FROM EpgEntries WHERE strTvgId = ? AND ") + string(strColumn) + string(" = ? AND endTime >= ? ORDER BY startTime"), sqlReader);
+	
+	// unlock reader connection if nothing to step
+	if (!sqlQuery)
+	{
+		UnlockReader(sqlReader);
+		return false;
+	}
+	
+	// bind channel, value, and end
+	BindQuery(sqlQuery, {strTvgId, strValue, iEnd});
+	
+	// hand statement and lock to cursor (released after last row)
+	sqlCursor.Open(sqlQuery, sqlReader ? &sqlReader->pMutex : &pMutex);
+	
+	// read rows up front when on writer (writer never held while rows are sent)
+	if (!sqlReader)
+		sqlCursor.Buffer();
+	
+	// return status
+	return true;
+}
+
+/***********************************************************
+ * Change Journal API Definitions
+ ***********************************************************/
+bool SQLConnection::GetChanges(const char* strTable, const long long iSequence, SQLCursor& sqlCursor)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create container for key column
+	string strKey;
+	
+	// look for key column (tables without one only journal swaps)
+	for (vector<SQLMsg>::iterator sqlMsg = sqlLog.begin(); sqlMsg != sqlLog.end(); sqlMsg++)
+		if (string(strTable) == sqlMsg->strTable)
+			strKey = sqlMsg->strKey;
+	
+	// create query text (latest change per key after sequence, current row joined when it still exists)
+	string strQuery = strKey.empty() ? string("SELECT Journal.iSequence, Journal.strKey, Journal.iAction FROM Journal") :
+	                                   string("SELECT Journal.iSequence, Journal.strKey, Journal.iAction, sqlRow.* FROM Journal LEFT JOIN ") + string(strTable) + string(" sqlRow ON sqlRow.") + strKey + string(" = Journal.strKey");
+	
+	strQuery += string(" WHERE Journal.strTable = ? AND Journal.iSequence > ?") +
+	            string(" AND Journal.iSequence = (SELECT MAX(iSequence) FROM Journal sqlLast WHERE sqlLast.strTable = Journal.strTable AND sqlLast.strKey = Journal.strKey)") +
+	            string(" ORDER BY Journal.iSequence");
+	
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
+	
+	// fetch compiled query for table changes
+	sqlite3_stmt *sqlQuery = PrepareQuery(strQuery, sqlReader);
+	
+	// unlock reader connection if nothing to step
+	if (!sqlQuery)
+	{
+		UnlockReader(sqlReader);
+		return false;
+	}
+	
+	// bind table and sequence
+	BindQuery(sqlQuery, {strTable, iSequence});
+	
+	// hand statement and lock to cursor (released after last row)
+	sqlCursor.Open(sqlQuery, sqlReader ? &sqlReader->pMutex : &pMutex);
+	
+	// read rows up front when on writer (writer never held while rows are sent)
+	if (!sqlReader)
+		sqlCursor.Buffer();
+	
+	// return status
+	return true;
+}
+
+/***********************************************************
+ * Typed Tables API Definitions
+ ***********************************************************/
+template <class T> bool SQLConnection::FetchRecords(const char* strTable, vector<T>& cRecords)
+{
+	// log function call
+	CPPLog(); 
 	
 	// clear vector
-	sqlReturn.clear();
-		
-	// create query and sql text
-	string sqlGetRecords = string("SELECT * FROM ") + string(strTable);
+	cRecords.clear();
 	
-	// call query
-	if (SendQuery(sqlGetRecords.c_str(), &sqlReturn) != SQLITE_OK)
-		sqlReturn.clear();
+	// open cursor on table
+	SQLCursor sqlCursor;
 	
-	// unlock threads
-	SetUnlock();
+	if (!GetRecords(strTable, sqlCursor))
+		return false;
+	
+	// fill objects straight from columns
+	while (sqlCursor.Next())
+		cRecords.push_back(T(sqlCursor.GetRow()));
 	
-	// return records
-	return sqlReturn;	
+	// log failure and clear partial results
+	if (sqlCursor.GetStatus() != SQLITE_OK)
+	{
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to read SQL table [%s] with error [%i]", __FUNCTION__, strTable, sqlCursor.GetStatus());
+		cRecords.clear();
+	}
+	
+	// return status
+	return (sqlCursor.GetStatus() == SQLITE_OK);
+}
+
+bool SQLConnection::GetRecords(const char* strTable, vector<IPTVChannel>& cRecords)
+{
+	// return typed records
+	return FetchRecords(strTable, cRecords);
+}
+
+bool SQLConnection::GetRecords(const char* strTable, vector<IPTVEpgChannel>& cRecords)
+{
+	// return typed records
+	return FetchRecords(strTable, cRecords);
+}
+
+bool SQLConnection::GetRecords(const char* strTable, vector<IPTVEpgEntry>& cRecords)
+{
+	// return typed records
+	return FetchRecords(strTable, cRecords);
+}
+
+bool SQLConnection::GetRecords(const char* strTable, vector<DVRTimer>& cRecords)
+{
+	// return typed records
+	return FetchRecords(strTable, cRecords);
 }
 
 /***********************************************************
@@ -456,6 +766,10 @@ void SQLConnection::Connect(void)
 	// log failure to connect
 	if (!bIsConnected)
 		XBMC->Log(LOG_ERROR, "C+: %s - Failed to open SQL database [%s] with error [%s]", __FUNCTION__, strDBPath.c_str(), sqlite3_errmsg(sqlDatabase));
+	
+	// wait on checkpoints instead of failing
+	if (bIsConnected)
+		sqlite3_busy_timeout(sqlDatabase, DATABASE_TIMEOUT);
 }
 
 void SQLConnection::Disconnect(bool bWait /* = true */)
@@ -470,6 +784,12 @@ void SQLConnection::Disconnect(bool bWait /* = true */)
 		sleep(1);
 	}
 	
+	// close reader connections
+	CloseReaders();
+	
+	// release compiled queries
+	ClearQueries();
+	
 	// close established connection
 	sqlite3_close(sqlDatabase);
 
@@ -478,43 +798,186 @@ void SQLConnection::Disconnect(bool bWait /* = true */)
 }
 
 /***********************************************************
- * Query Definitions
+ * Reader Pool Definitions
  ***********************************************************/
-static int cCallback(void *ObjPtr, int Vars, char** ColVal, char** ColName)
+void SQLConnection::OpenReaders(void)
 {
 	// log function call
 	CPPLog(); 
 	
-	// create pointer to class
-	SQLConnection *SQL = reinterpret_cast<SQLConnection*>(ObjPtr);
+	// only open if connected
+	if (!bIsConnected)
+		return;
 	
-	// return value from class callback
-	return SQL->Callback(Vars, ColVal, ColName);	
+	// readers see last commit while writer holds a transaction
+	SendQuery("PRAGMA journal_mode = WAL"   , NULL);
+	SendQuery("PRAGMA synchronous  = NORMAL", NULL);
+	
+	// open read only connections
+	for (int i = 0; i < DATABASE_READERS; i++)
+	{
+		// create reader
+		SQLReader *sqlReader = new SQLReader;
+		sqlReader->sqlDatabase = NULL;
+		
+		// attempt to establish a connection
+		if (sqlite3_open_v2(strDBPath.c_str(), &sqlReader->sqlDatabase, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK)
+		{
+			// log failure (reads fall back to writer)
+			XBMC->Log(LOG_ERROR, "C+: %s - Failed to open SQL reader [%s] with error [%s]", __FUNCTION__, strDBPath.c_str(), sqlite3_errmsg(sqlReader->sqlDatabase));
+			
+			// release reader
+			sqlite3_close(sqlReader->sqlDatabase);
+			delete sqlReader;
+			
+			// stop opening
+			break;
+		}
+		
+		// wait on checkpoints instead of failing
+		sqlite3_busy_timeout(sqlReader->sqlDatabase, DATABASE_TIMEOUT);
+		
+		// add to pool
+		sqlReaders.push_back(sqlReader);
+	}
+	
+	// log pool size
+	XBMC->Log(LOG_NOTICE, "C+: %s - Opened %i SQL readers", __FUNCTION__, (int)sqlReaders.size());
 }
 
-int SQLConnection::Callback(int Vars, char** ColVal, char** ColName) 
+void SQLConnection::CloseReaders(void)
 {
 	// log function call
 	CPPLog(); 
 	
-	// create container for string
-	string strRecord;
-	
-	// parse call back data to buffer
-	for(int i = 0; i < Vars; i++)
-		strRecord += string("<") + string(ColName[i]) + string(">") + string(ColVal[i] ? ColVal[i] : "") + string("</") + string(ColName[i]) + string(">");
-	
-	// create record object
-	SQLRecord sqlRecord(strRecord);
+	// close readers once idle
+	for (vector<SQLReader*>::iterator sqlReader = sqlReaders.begin(); sqlReader != sqlReaders.end(); sqlReader++)
+	{
+		// wait for current query
+		(*sqlReader)->pMutex.lock();
+		
+		// release compiled queries and connection
+		ClearQueries(*sqlReader);
+		sqlite3_close((*sqlReader)->sqlDatabase);
+		
+		// release reader
+		(*sqlReader)->pMutex.unlock();
+		delete *sqlReader;
+	}
 	
-	// push back to callback
-	sqlCallback.push_back(sqlRecord);
-
-	// return to query
-	return 0;
+	// clear pool
+	sqlReaders.clear();
 }
 
-int SQLConnection::SendQuery(const char* strSyntax, void* sqlResponse)
+SQLReader* SQLConnection::LockReader(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// use writer if no readers
+	if (sqlReaders.empty())
+	{
+		// lock threads
+		SetLock();
+		
+		// return writer
+		return NULL;
+	}
+	
+	// take first idle reader
+	for (vector<SQLReader*>::iterator sqlReader = sqlReaders.begin(); sqlReader != sqlReaders.end(); sqlReader++)
+		if ((*sqlReader)->pMutex.try_lock())
+			return *sqlReader;
+	
+	// otherwise queue on readers in turn
+	pReadMutex.lock();
+	SQLReader *sqlReader = sqlReaders[iNextRead++ % sqlReaders.size()];
+	pReadMutex.unlock();
+	
+	// wait for reader
+	sqlReader->pMutex.lock();
+	
+	// return reader
+	return sqlReader;
+}
+
+void SQLConnection::UnlockReader(SQLReader* sqlReader)
+{
+	// log function call
+	CPPLog(); 
+	
+	// release writer or reader
+	if (sqlReader)
+		sqlReader->pMutex.unlock();
+	else
+		SetUnlock();
+}
+
+/***********************************************************
+ * Transaction Definitions
+ ***********************************************************/
+void SQLConnection::BeginTransaction(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock threads (held until end, writes from other threads wait instead of joining)
+	SetLock();
+	
+	// start transaction
+	sqlite3_exec(sqlDatabase, "BEGIN TRANSACTION;", NULL, NULL, NULL);
+}
+
+void SQLConnection::EndTransaction(bool bCommit /* = true */)
+{
+	// log function call
+	CPPLog(); 
+	
+	// end or roll back transaction
+	sqlite3_exec(sqlDatabase, bCommit ? "END TRANSACTION;" : "ROLLBACK;", NULL, NULL, NULL);
+	
+	// unlock threads
+	SetUnlock();
+}
+
+/***********************************************************
+ * Query Definitions
+ ***********************************************************/
+static int cCallback(void *ObjPtr, int Vars, char** ColVal, char** ColName)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create pointer to class
+	SQLConnection *SQL = reinterpret_cast<SQLConnection*>(ObjPtr);
+	
+	// return value from class callback
+	return SQL->Callback(Vars, ColVal, ColName);	
+}
+
+int SQLConnection::Callback(int Vars, char** ColVal, char** ColName) 
+{
+	// log function call
+	CPPLog(); 
+	
+	// create container for string
+	string strRecord;
+	
+	// parse call back data to buffer
+	for(int i = 0; i < Vars; i++)
+		strRecord += string("<") + string(ColName[i]) + string(">") + EscapeSQLValue(ColVal[i] ? ColVal[i] : "") + string("</") + string(ColName[i]) + string(">");
+	
+	// create record object
+	SQLRecord sqlRecord(strRecord);
+	
+	// push back to callback
+	sqlCallback.push_back(sqlRecord);
+
+	// return to query
+	return 0;
+}
+
+int SQLConnection::SendQuery(const char* strSyntax, void* sqlResponse)
 {
 	// log function call
 	CPPLog(); 
@@ -539,14 +1002,246 @@ int SQLConnection::SendQuery(const char* strSyntax, void* sqlResponse)
 		// create pointer to vector
 		vector<SQLRecord> *sqlReturn = reinterpret_cast<vector<SQLRecord>*>(sqlResponse);
 		
-		// assign callback buffer to response
-		*sqlReturn = sqlCallback;
+		// move callback buffer to response
+		sqlReturn->swap(sqlCallback);
+	}
+
+	// return message
+	return iResponse;
+}
+
+/***********************************************************
+ * Prepared Query Definitions
+ ***********************************************************/
+sqlite3_stmt* SQLConnection::PrepareQuery(const string strSyntax, SQLReader* sqlReader /* = NULL */)
+{
+	// log function call
+	CPPLog(); 
+	
+	// use reader connection and cache if given
+	sqlite3                    *sqlHandle = sqlReader ? sqlReader->sqlDatabase    : sqlDatabase   ;
+	map<string, sqlite3_stmt*> &sqlCache  = sqlReader ? sqlReader->sqlStatements  : sqlStatements ;
+	
+	// look for compiled query (syntax is unique per table and operation)
+	map<string, sqlite3_stmt*>::iterator sqlStatement = sqlCache.find(strSyntax);
+	
+	// reuse compiled query if found
+	if (sqlStatement != sqlCache.end())
+	{
+		// rewind and drop previous values
+		sqlite3_reset(sqlStatement->second);
+		sqlite3_clear_bindings(sqlStatement->second);
+		
+		// return cached query
+		return sqlStatement->second;
+	}
+	
+	// create container for compiled query
+	sqlite3_stmt *sqlQuery = NULL;
+	
+	// attempt to compile query
+	if (sqlite3_prepare_v2(sqlHandle, strSyntax.c_str(), -1, &sqlQuery, NULL) != SQLITE_OK)
+	{
+		// log failure
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to prepare SQL query [%s] with error [%s]", __FUNCTION__, strSyntax.c_str(), sqlite3_errmsg(sqlHandle));
+		
+		// release partial query
+		sqlite3_finalize(sqlQuery);
+		
+		// return error
+		return NULL;
+	}
+	
+	// add to cache
+	sqlCache[strSyntax] = sqlQuery;
+	
+	// return compiled query
+	return sqlQuery;
+}
+
+void SQLConnection::BindQuery(sqlite3_stmt* sqlQuery, const vector<SQLValue>& sqlValues)
+{
+	// log function call
+	CPPLog(); 
+	
+	// bind values in order
+	for (int i = 0; i < (int)sqlValues.size(); i++)
+	{
+		switch (sqlValues[i].iType)
+		{
+			case SQL_VALUE_INT:
+				sqlite3_bind_int64 (sqlQuery, i+1, sqlValues[i].iValue                                  );
+				break;
+			case SQL_VALUE_FLOAT:
+				sqlite3_bind_double(sqlQuery, i+1, sqlValues[i].fValue                                  );
+				break;
+			case SQL_VALUE_TEXT:
+				sqlite3_bind_text  (sqlQuery, i+1, sqlValues[i].strValue.c_str(), -1, SQLITE_TRANSIENT);
+				break;
+		}
+	}
+}
+
+int SQLConnection::StepQuery(sqlite3_stmt* sqlQuery, void* sqlResponse)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create local containers (readers run in parallel so no shared callback buffer)
+	int               iResponse = SQLITE_OK;
+	int               iColumns  = sqlite3_column_count(sqlQuery);
+	vector<SQLRecord> sqlRecords;
+	
+	// step through rows
+	while ((iResponse = sqlite3_step(sqlQuery)) == SQLITE_ROW)
+	{
+		// create container for string
+		string strRecord;
+		
+		// parse row data to buffer
+		for (int i = 0; i < iColumns; i++)
+		{
+			// get column name and value
+			const char* ColName = sqlite3_column_name(sqlQuery, i);
+			const char* ColVal  = (const char*)sqlite3_column_text(sqlQuery, i);
+			
+			// append to record
+			strRecord += string("<") + string(ColName) + string(">") + EscapeSQLValue(ColVal ? ColVal : "") + string("</") + string(ColName) + string(">");
+		}
+		
+		// push back to buffer
+		sqlRecords.push_back(SQLRecord(strRecord));
+	}
+	
+	// translate completion
+	iResponse = (iResponse == SQLITE_DONE) ? SQLITE_OK : iResponse;
+	
+	// log failure
+	if (iResponse != SQLITE_OK)
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to query SQL database [%s] with error [%s]", __FUNCTION__, sqlite3_sql(sqlQuery), sqlite3_errmsg(sqlite3_db_handle(sqlQuery)));
+	
+	// release statement so it does not hold the database
+	sqlite3_reset(sqlQuery);
+	
+	// assign data if not null
+	if (sqlResponse)
+	{
+		// create pointer to vector
+		vector<SQLRecord> *sqlReturn = reinterpret_cast<vector<SQLRecord>*>(sqlResponse);
+		
+		// move buffer to response
+		sqlReturn->swap(sqlRecords);
 	}
+	
+	// return message
+	return iResponse;
+}
 
+void SQLConnection::ClearQueries(SQLReader* sqlReader /* = NULL */)
+{
+	// log function call
+	CPPLog(); 
+	
+	// use reader cache if given
+	map<string, sqlite3_stmt*> &sqlCache = sqlReader ? sqlReader->sqlStatements : sqlStatements;
+	
+	// finalize compiled queries
+	for (map<string, sqlite3_stmt*>::iterator sqlStatement = sqlCache.begin(); sqlStatement != sqlCache.end(); sqlStatement++)
+		sqlite3_finalize(sqlStatement->second);
+	
+	// clear cache
+	sqlCache.clear();
+}
+
+/***********************************************************
+ * Change Log Definitions
+ ***********************************************************/
+void SQLConnection::UpdateDBLog(const char* strTable)
+{
+	// log function call
+	CPPLog(); 
+	
+	// update change log
+	for (vector<SQLMsg>::iterator sqlMsg = sqlLog.begin(); sqlMsg != sqlLog.end(); sqlMsg++)
+		if (string(strTable) == sqlMsg->strTable)
+			sqlMsg->iModTime = time(NULL);
+	
+	// wake scheduler if timers changed
+	if (string(strTable) == "Timers")
+		WakeSchedule();
+}
+
+int SQLConnection::ResetJournal(const char* strTable)
+{
+	// log function call
+	CPPLog(); 
+	
+	// fetch compiled queries for reset entry and older entries (caller holds lock)
+	sqlite3_stmt *sqlInsert = PrepareQuery("INSERT INTO Journal (strTable, strKey, iAction, iModTime) VALUES (?, '', ?, ?)");
+	sqlite3_stmt *sqlDelete = PrepareQuery("DELETE FROM Journal WHERE strTable = ? AND iSequence < ?"                     );
+	
+	// return error if not compiled
+	if (!sqlInsert || !sqlDelete)
+		return SQLITE_ERROR;
+	
+	// add reset entry
+	BindQuery(sqlInsert, {strTable, (int)SQL_JOURNAL_RESET, (long long)time(NULL)});
+	
+	int iResponse = StepQuery(sqlInsert, NULL);
+	
+	// drop entries the reset replaces (clients behind it reload the table)
+	if (iResponse == SQLITE_OK)
+	{
+		BindQuery(sqlDelete, {strTable, (long long)sqlite3_last_insert_rowid(sqlDatabase)});
+		
+		iResponse = StepQuery(sqlDelete, NULL);
+	}
+	
 	// return message
 	return iResponse;
 }
 
+void SQLConnection::PruneJournal(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock threads
+	SetLock();
+	
+	// fetch compiled query for row entries past retention
+	sqlite3_stmt *sqlQuery = PrepareQuery("SELECT COUNT(*) FROM Journal WHERE strTable = ? AND iAction <> ? AND iModTime < ?");
+	
+	// iterate through log
+	for (vector<SQLMsg>::iterator sqlMsg = sqlLog.begin(); sqlMsg != sqlLog.end() && sqlQuery; sqlMsg++)
+	{
+		// create container for count
+		int iExpired = 0;
+		
+		// bind table and read count directly
+		BindQuery(sqlQuery, {sqlMsg->strTable, (int)SQL_JOURNAL_RESET, (long long)(time(NULL) - DATABASE_JOURNAL*SECONDS_IN_DAY)});
+			
+		if (sqlite3_step(sqlQuery) == SQLITE_ROW)
+			iExpired = sqlite3_column_int(sqlQuery, 0);
+			
+		// release statement
+		sqlite3_reset(sqlQuery);
+		
+		// replace expired entries with a reset
+		if (iExpired)
+		{
+			// log prune
+			XBMC->Log(LOG_NOTICE, "C+: %s - Pruned %i journal entries for table [%s]", __FUNCTION__, iExpired, sqlMsg->strTable.c_str());
+			
+			// reset table
+			ResetJournal(sqlMsg->strTable.c_str());
+		}
+	}
+	
+	// unlock threads
+	SetUnlock();
+}
+
 /***********************************************************
  * SQL Server Process Definitions
  ***********************************************************/
@@ -558,17 +1253,23 @@ void *SQLConnection::Process(void)
 	// set thread working
 	bIsWorking = true;
 	
-	// create vector to hold current timers
-	vector<SQLRecord> sqlTimers;	
+	// create vector to hold current timers (reloaded only when timers change)
+	vector<DVRTimer> cTimers;
 	
 	// create last checked interval
 	time_t lastCheck = time(NULL) - settings->GetSchedPoll();
 	
+	// create container for loader state at last pass
+	bool bWasLoading = true;
+	
+	// start loader (playlist and guide load and refresh without holding up deadlines)
+	tLoader = thread(&SQLConnection::LoadSources, this);
+	
 	// execute scheduler
 	while (!bStop)
 	{
-		// sleep thread so machine doesn't idle at 100% cpu
-		sleep(1);
+		// sleep thread until next deadline, timer change, or polling interval
+		WaitSchedule(lastCheck + settings->GetSchedPoll());
 		
 		// check connection
 		if (XBMC->FileExists(strDBPath.c_str(), false))
@@ -586,116 +1287,34 @@ void *SQLConnection::Process(void)
 			// set connection
 			bIsConnected = true;
 			
-			// if polling interval passed to check timers    
-			if (lastCheck + settings->GetSchedPoll() <= time(NULL))
-			{		
-				// clear container
-				sqlTimers.clear();
-	
-				// read current timers
-				sqlTimers = GetRecords("Timers");
+			// reload timers and deadlines if changed
+			if (IsScheduleChanged())
+				LoadSchedule(cTimers);
+			
+			// start, stop, or drop timers whose deadline passed
+			RunSchedule(cTimers);
+			
+			// check if loader finished first load since last pass
+			bool bLoading = IsLoading();
+			bool bLoaded  = bWasLoading && !bLoading;
+			
+			bWasLoading = bLoading;
+			
+			// if polling interval passed or guide just loaded to expand timer rules and clean data
+			if (lastCheck + settings->GetSchedPoll() <= time(NULL) || bLoaded)
+			{
+				// schedule timer rules changed or with changed guide
+				ExpandSchedule(cTimers);
 				
-				// iterate through timers and schedule timers, start rec, stop rec
-				for (vector<SQLRecord>::iterator sqlTimer = sqlTimers.begin(); sqlTimer != sqlTimers.end(); sqlTimer++)
-				{	
-					// convert to pvr timer
-					DVRTimer cTimer(sqlTimer->GetRecord());
-					
-					// scheduled events
-					if (cTimer.GetState() == PVR_TIMER_STATE_SCHEDULED)
-					{
-						// start & stop recording for scheduled timers
-						if (cTimer.GetTimerType() == TIMER_ONCE_MANUAL || cTimer.GetTimerType() == TIMER_ONCE_EPG)
-						{
-							// call delete timer if missed
-							if (cTimer.GetEndTime()   + cTimer.GetMarginEnd()*0    < time(NULL) - settings->GetSchedPoll())
-								this->DeleteTimer(cTimer.Timer());
-
-							// call start recording if start time is now
-							if (cTimer.GetStartTime() - cTimer.GetMarginStart()*60 < time(NULL) - settings->GetSchedPoll())
-								this->StartTimer(cTimer.Timer());
-						}
-						
-						// schedule timer rules
-						if (cTimer.GetTimerType() == TIMER_REPEATING_MANUAL || cTimer.GetTimerType() == TIMER_REPEATING_EPG || cTimer.GetTimerType() == TIMER_REPEATING_SERIESLINK)
-						{
-							// call scheduling to explode past timer rule
-							if (cTimer.GetEndTime()   + cTimer.GetMarginEnd()*0    <= time(NULL) - settings->GetSchedPoll())
-								this->ScheduleTimer(cTimer.Timer());				
-
-							// call scheduling to explode future timer rule
-							if (cTimer.GetEndTime()   + cTimer.GetMarginEnd()*0    >= time(NULL) - settings->GetSchedPoll())
-								this->ScheduleTimer(cTimer.Timer());									
-						}
-					}
-					
-					// completed timers
-					if (cTimer.GetState() == PVR_TIMER_STATE_ERROR    )
-					{
-						// start & stop recording for scheduled timers
-						if (cTimer.GetTimerType() == TIMER_ONCE_MANUAL || cTimer.GetTimerType() == TIMER_ONCE_EPG)
-						{
-							// call delete timer if error and missed
-							if (cTimer.GetEndTime()   + cTimer.GetMarginEnd()*0    < time(NULL) - settings->GetSchedPoll())
-								this->DeleteTimer(cTimer.Timer());
-							
-							// call start recording to retry start time is now
-							if (cTimer.GetStartTime() - cTimer.GetMarginStart()*60 < time(NULL) - settings->GetSchedPoll())
-								this->StartTimer(cTimer.Timer());	
-						}
-					}
-					  
-					// recording timers
-					if (cTimer.GetState() == PVR_TIMER_STATE_RECORDING)
-					{
-						// start & stop recording for scheduled timers
-						if (cTimer.GetTimerType() == TIMER_ONCE_MANUAL || cTimer.GetTimerType() == TIMER_ONCE_EPG)
-						{
-							// call to delete timer if recording over
-							if (cTimer.GetEndTime()   + cTimer.GetMarginEnd()*60   < time(NULL) + settings->GetSchedPoll())
-								this->StopTimer(cTimer.Timer());
-						}
-					}
-				}
+				// drop journal entries past retention
+				PruneJournal();
 				
-				// reload M3U if enabled
-				if (settings->GetM3URefresh())
-				{
-					if (LastM3URead() + ((SECONDS_IN_DAY)*((settings->GetM3URefresh()) == 2 ? 7 : 1)) < time(NULL))
-					{
-						// log reload
-						XBMC->Log(LOG_NOTICE, "C+: %s - The M3U refresh interval has passed, proceed to import", __FUNCTION__);
-						  
-						// clear data
-						SetLock();
-						ClearChannels();
-						ClearChannelGroups();
-						ClearChannelGroupMembers();
-						SetUnlock();
-						
-						// reload playlist						
-						ImportM3U();
-					}
-				}
-
-				// reload EPG if enabled
-				if (settings->GetEPGRefresh())
-				{
-					if (LastEPGRead() + ((SECONDS_IN_DAY)*((settings->GetEPGRefresh()) == 2 ? 7 : 1)) < time(NULL))
-					{
-						// log reload
-						XBMC->Log(LOG_NOTICE, "C+: %s - The EPG refresh interval has passed, proceed to import", __FUNCTION__);
-						  
-						// clear data
-						SetLock();
-						ClearGuideChannels();
-						ClearGuideEntries();
-						SetUnlock();
-						
-						// reload programming guide
-						ImportXMLTV();
-					}
-				}
+				// drop guide entries past horizon (hourly, ended programmes only)
+				if (tLastEPGClean + SECONDS_IN_HOUR <= time(NULL))
+					CleanEpgEntries();
+				
+				// log last check
+				lastCheck = time(NULL);
 			}
 		}
 		else
@@ -712,35 +1331,41 @@ void *SQLConnection::Process(void)
 			
 			// set connection
 			bIsConnected = false;
+			
+			// sleep thread so machine doesn't idle at 100% cpu
+			sleep(1);
 		}
 	}
+	
+	// wake loader so it sees stop and wait for it (an import in progress finishes first)
+	WakeLoader();
+	
+	if (tLoader.joinable())
+		tLoader.join();
 
 	// iterate through timers and stop all recordings
-	sqlTimers.clear();
+	cTimers.clear();
 
 	// read current timers
-	sqlTimers = GetRecords("Timers");
+	GetRecords("Timers", cTimers);
 	
 	// iterate through timers and stop all rec
-	for (vector<SQLRecord>::iterator sqlTimer = sqlTimers.begin(); sqlTimer != sqlTimers.end(); sqlTimer++)
+	for (vector<DVRTimer>::iterator cTimer = cTimers.begin(); cTimer != cTimers.end(); cTimer++)
 	{	
-		// convert to pvr timer
-		DVRTimer cTimer(sqlTimer->GetRecord());
-					
 		// recording timers
-		if (cTimer.GetState() == PVR_TIMER_STATE_RECORDING)
+		if (cTimer->GetState() == PVR_TIMER_STATE_RECORDING)
 		{
 			// stop recording for scheduled timers
-			if (cTimer.GetTimerType() == TIMER_ONCE_MANUAL || cTimer.GetTimerType() == TIMER_ONCE_EPG)
+			if (cTimer->GetTimerType() == TIMER_ONCE_MANUAL || cTimer->GetTimerType() == TIMER_ONCE_EPG)
 			{
 				// call to delete timer if recording (program exit)
-				this->StopTimer(cTimer.Timer());
+				this->StopTimer(cTimer->Timer());
 			}
 		}
 	}	
 
 	// clear local containers
-	sqlTimers.clear();
+	cTimers.clear();
 
 	// end thread work
 	bIsWorking = false;
@@ -752,6 +1377,500 @@ void *SQLConnection::Process(void)
 	return NULL;
 }
 
+/***********************************************************
+ * Loader Definitions
+ ***********************************************************/
+void SQLConnection::LoadSources(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// load and refresh until stopped
+	while (!bStop)
+	{
+		// only import while database is reachable
+		if (IsConnected())
+		{
+			// load playlist and guide on first pass (clients notified through change log)
+			if (IsLoading())
+			{
+				// log load
+				XBMC->Log(LOG_NOTICE, "C+: %s - Loading playlist and guide in background", __FUNCTION__);
+				
+				// import external files
+				ImportM3U();
+				ImportXMLTV();
+				
+				// apply filters
+				FilterChannelsEPG();
+				
+				// mark as loaded
+				bIsLoading = false;
+				
+				// wake scheduler to expand timer rules against loaded guide
+				WakeSchedule();
+				
+				// log load
+				XBMC->Log(LOG_NOTICE, "C+: %s - Loaded playlist and guide", __FUNCTION__);
+			}
+			
+			// reload M3U if enabled
+			if (settings->GetM3URefresh())
+			{
+				if (LastM3URead() + ((SECONDS_IN_DAY)*((settings->GetM3URefresh()) == 2 ? 7 : 1)) < time(NULL))
+				{
+					// log reload
+					XBMC->Log(LOG_NOTICE, "C+: %s - The M3U refresh interval has passed, proceed to import", __FUNCTION__);
+					
+					// reload playlist (current tables stay readable until merge)
+					ImportM3U();
+				}
+			}
+
+			// reload EPG if enabled
+			if (settings->GetEPGRefresh())
+			{
+				if (LastEPGRead() + ((SECONDS_IN_DAY)*((settings->GetEPGRefresh()) == 2 ? 7 : 1)) < time(NULL))
+				{
+					// log reload
+					XBMC->Log(LOG_NOTICE, "C+: %s - The EPG refresh interval has passed, proceed to import", __FUNCTION__);
+					
+					// reload programming guide (current tables stay readable until commit)
+					ImportXMLTV();
+				}
+			}
+		}
+		
+		// sleep thread until polling interval or stop
+		WaitLoader(time(NULL) + settings->GetSchedPoll());
+	}
+}
+
+void SQLConnection::WakeLoader(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// pass through lock so a loader about to sleep sees stop first
+	pLoadMutex.lock();
+	pLoadMutex.unlock();
+	
+	// wake loader thread
+	cLoad.notify_all();
+}
+
+void SQLConnection::WaitLoader(const time_t tPoll)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock loader
+	unique_lock<mutex> pLock(pLoadMutex);
+	
+	// sleep until polling interval unless stopping (no sooner than a second)
+	if (!bStop)
+		cLoad.wait_until(pLock, chrono::system_clock::from_time_t(max(tPoll, time(NULL) + 1)));
+}
+
+/***********************************************************
+ * Timer Schedule Definitions
+ ***********************************************************/
+void SQLConnection::WakeSchedule(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// flag timers as changed
+	pScheduleMutex.lock();
+	bScheduleChanged = true;
+	pScheduleMutex.unlock();
+	
+	// wake scheduler thread
+	cSchedule.notify_all();
+}
+
+bool SQLConnection::IsScheduleChanged(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// read flag
+	pScheduleMutex.lock();
+	bool bChanged = bScheduleChanged;
+	pScheduleMutex.unlock();
+	
+	// return value
+	return bChanged;
+}
+
+void SQLConnection::WaitSchedule(const time_t tPoll)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock schedule
+	unique_lock<mutex> pLock(pScheduleMutex);
+	
+	// wake at polling interval or earliest deadline (whichever first, polling no sooner than a second)
+	time_t tWake = max(tPoll, time(NULL) + 1);
+	
+	if (!sqlDeadlines.empty() && sqlDeadlines.top().tDeadline < tWake)
+		tWake = sqlDeadlines.top().tDeadline;
+	
+	// sleep until woken unless timers changed, stopping, or already due
+	if (!bScheduleChanged && !bStop && tWake > time(NULL))
+		cSchedule.wait_until(pLock, chrono::system_clock::from_time_t(tWake));
+}
+
+void SQLConnection::LoadSchedule(vector<DVRTimer>& cTimers)
+{
+	// log function call
+	CPPLog(); 
+	
+	// clear flag before reading (changes made while reading load again)
+	pScheduleMutex.lock();
+	bScheduleChanged = false;
+	pScheduleMutex.unlock();
+	
+	// read current timers
+	cTimers.clear();
+	GetRecords("Timers", cTimers);
+	
+	// lock schedule
+	pScheduleMutex.lock();
+	
+	// clear deadlines
+	while (!sqlDeadlines.empty())
+		sqlDeadlines.pop();
+	
+	// queue next deadline of each timer (timer rules expanded on polling interval instead)
+	for (int i = 0; i < (int)cTimers.size(); i++)
+	{
+		// only look for once timers
+		if (cTimers[i].GetTimerType() != TIMER_ONCE_MANUAL && cTimers[i].GetTimerType() != TIMER_ONCE_EPG)
+			continue;
+		
+		// create deadline (higher priority first on same deadline)
+		SQLDeadline sqlDeadline;
+		
+		sqlDeadline.iPriority = cTimers[i].GetPriority();
+		sqlDeadline.iTimer    = i;
+		
+		// scheduled timers start at start time less margin and pre-roll (recorder connects early, trims to margin)
+		if      (cTimers[i].GetState() == PVR_TIMER_STATE_SCHEDULED   )
+			sqlDeadline.tDeadline =     cTimers[i].GetStartTime() - cTimers[i].GetMarginStart()*60 - settings->GetPreRoll()                                        ;
+		
+		// conflicting timers retry start whenever timers change (recording slot may have freed)
+		else if (cTimers[i].GetState() == PVR_TIMER_STATE_CONFLICT_NOK)
+			sqlDeadline.tDeadline =     cTimers[i].GetStartTime() - cTimers[i].GetMarginStart()*60 - settings->GetPreRoll()                                        ;
+		
+		// failed timers retry start after polling interval
+		else if (cTimers[i].GetState() == PVR_TIMER_STATE_ERROR       )
+			sqlDeadline.tDeadline = max(cTimers[i].GetStartTime() - cTimers[i].GetMarginStart()*60 - settings->GetPreRoll(), time(NULL) + settings->GetSchedPoll());
+		
+		// recording timers stop at end time plus margin
+		else if (cTimers[i].GetState() == PVR_TIMER_STATE_RECORDING   )
+			sqlDeadline.tDeadline =     cTimers[i].GetEndTime()   + cTimers[i].GetMarginEnd()  *60                                                                 ;
+		
+		// other states have nothing to do
+		else
+			continue;
+		
+		// add to queue
+		sqlDeadlines.push(sqlDeadline);
+	}
+	
+	// unlock schedule
+	pScheduleMutex.unlock();
+}
+
+void SQLConnection::RunSchedule(vector<DVRTimer>& cTimers)
+{
+	// log function call
+	CPPLog(); 
+	
+	// go through passed deadlines (stop once timers change so loaded rows are never stale)
+	while (!IsScheduleChanged())
+	{
+		// create container for deadline
+		SQLDeadline sqlDeadline;
+		bool        bDue = false;
+		
+		// take earliest deadline if passed
+		pScheduleMutex.lock();
+		
+		if (!sqlDeadlines.empty() && sqlDeadlines.top().tDeadline <= time(NULL))
+		{
+			sqlDeadline = sqlDeadlines.top();
+			sqlDeadlines.pop();
+			bDue = true;
+		}
+		
+		pScheduleMutex.unlock();
+		
+		// exit loop if nothing due
+		if (!bDue)
+			break;
+		
+		// point to timer
+		DVRTimer *cTimer = &cTimers[sqlDeadline.iTimer];
+		
+		// call stop recording if recording over
+		if      (cTimer->GetState()   == PVR_TIMER_STATE_RECORDING)
+			this->StopTimer(cTimer->Timer());
+		
+		// call delete timer if missed
+		else if (cTimer->GetEndTime() <  time(NULL)               )
+			this->DeleteTimer(cTimer->Timer());
+		
+		// call start recording if start time is now and a recording slot is free (or retry if failed)
+		else if (this->AdmitTimer(*cTimer, cTimers)               )
+			this->StartTimer(cTimer->Timer());
+		
+		// flag conflict so clients see it before stream time
+		else if (cTimer->GetState()   != PVR_TIMER_STATE_CONFLICT_NOK)
+			this->UpdateRecord("Timers", " SET state = ? WHERE iClientIndex = ?", {(int)PVR_TIMER_STATE_CONFLICT_NOK, cTimer->GetClientIndex()});
+		
+		// retry conflict after polling interval (already flagged, no write)
+		else
+		{
+			sqlDeadline.tDeadline = time(NULL) + max(settings->GetSchedPoll(), 1);
+			
+			pScheduleMutex.lock();
+			sqlDeadlines.push(sqlDeadline);
+			pScheduleMutex.unlock();
+		}
+	}
+}
+
+void SQLConnection::ExpandSchedule(vector<DVRTimer>& cTimers)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create containers for guide sequence and rule keys
+	long long                 iSequence = 0;
+	map<unsigned int, string> strKeys      ;
+	
+	// lock threads
+	SetLock();
+	
+	// fetch compiled query for last change to channels, guide, or recordings (recorded episodes are not scheduled again)
+	sqlite3_stmt *sqlQuery = PrepareQuery("SELECT MAX(iSequence) FROM Journal WHERE strTable IN ('Channels', 'EpgChannels', 'EpgEntries', 'Recordings')");
+	
+	// read sequence directly
+	if (sqlQuery)
+	{
+		if (sqlite3_step(sqlQuery) == SQLITE_ROW)
+			iSequence = sqlite3_column_int64(sqlQuery, 0);
+		
+		// release statement
+		sqlite3_reset(sqlQuery);
+	}
+	
+	// unlock threads
+	SetUnlock();
+	
+	// get day of year (manual rules roll forward daily)
+	time_t tNow = time(NULL);
+	int    iDay = localtime(&tNow)->tm_yday;
+	
+	// iterate through timer rules (timers added are appended so later rules skip them)
+	for (int i = 0, iTimers = (int)cTimers.size(); i < iTimers; i++)
+	{
+		// only look for scheduled timer rules
+		if (cTimers[i].GetState() != PVR_TIMER_STATE_SCHEDULED)
+			continue;
+		
+		if (cTimers[i].GetTimerType() != TIMER_REPEATING_MANUAL && cTimers[i].GetTimerType() != TIMER_REPEATING_EPG && cTimers[i].GetTimerType() != TIMER_REPEATING_SERIESLINK)
+			continue;
+		
+		// create key from fields that change expansion
+		string strKey = itos(cTimers[i].GetTimerType())      + "," + itos(cTimers[i].GetClientChannelUid()) + "," +
+		                itos(cTimers[i].GetStartTime())      + "," + itos(cTimers[i].GetEndTime())          + "," +
+		                btos(cTimers[i].GetStartAnyTime())   + "," + btos(cTimers[i].GetEndAnyTime())       + "," +
+		                itos(cTimers[i].GetWeekdays())       + "," + itos(iDay)                             + "," +
+		                itos(cTimers[i].GetPreventDuplicateEpisodes())                                      + "," +
+		                     cTimers[i].GetTitle()           + "," +      cTimers[i].GetSeriesLink()               ;
+		
+		// keep key for next pass
+		strKeys[cTimers[i].GetClientIndex()] = strKey;
+		
+		// skip if rule and guide unchanged since last expansion
+		map<unsigned int, string>::iterator strExpandKey = strExpandKeys.find(cTimers[i].GetClientIndex());
+		
+		if (iSequence == iExpandSequence && strExpandKey != strExpandKeys.end() && strExpandKey->second == strKey)
+			continue;
+		
+		// schedule timer rule
+		this->ScheduleTimer(cTimers[i].Timer(), cTimers);
+	}
+	
+	// keep guide sequence and rules expanded
+	iExpandSequence = iSequence;
+	strExpandKeys.swap(strKeys);
+}
+
+string SQLConnection::GetTimerKey(const int iChannelUid, const time_t startTime, const time_t endTime)
+{
+	// return key of airing
+	return itos(iChannelUid) + string(",") + to_string((long long)startTime) + string(",") + to_string((long long)endTime);
+}
+
+string SQLConnection::GetEpisodeKey(const string strTitle, const int iSeriesNumber, const int iEpisodeNumber, const string strEpisodeName)
+{
+	// key by season and episode if numbered
+	if (iSeriesNumber > 0 && iEpisodeNumber > 0)
+		return strTitle + string(",S") + itos(iSeriesNumber) + string("E") + itos(iEpisodeNumber);
+	
+	// key by episode name if named
+	if (strEpisodeName != "")
+		return strTitle + string(",") + strEpisodeName;
+	
+	// return no key (episode can not be told apart)
+	return "";
+}
+
+void SQLConnection::GetEpisodes(const string strTitle, unordered_set<string>& strEpisodes)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock reader connection
+	SQLReader *sqlReader = LockReader();
+	
+	// fetch compiled query for recordings of title
+	sqlite3_stmt *sqlQuery = PrepareQuery("SELECT iSeriesNumber, iEpisodeNumber, strEpisodeName FROM Recordings WHERE strTitle = ?", sqlReader);
+	
+	// bind title and read episodes directly
+	if (sqlQuery)
+	{
+		BindQuery(sqlQuery, {strTitle});
+		
+		while (sqlite3_step(sqlQuery) == SQLITE_ROW)
+		{
+			// get episode name
+			const char *strEpisodeName = (const char*)sqlite3_column_text(sqlQuery, 2);
+			
+			// create key
+			string strEpisodeKey = GetEpisodeKey(strTitle, sqlite3_column_int(sqlQuery, 0), sqlite3_column_int(sqlQuery, 1), strEpisodeName ? strEpisodeName : "");
+			
+			// add if episode can be told apart
+			if (strEpisodeKey != "")
+				strEpisodes.insert(strEpisodeKey);
+		}
+		
+		// release statement
+		sqlite3_reset(sqlQuery);
+	}
+	
+	// unlock reader connection
+	UnlockReader(sqlReader);
+}
+
+/***********************************************************
+ * Recording Admission Definitions
+ ***********************************************************/
+string SQLConnection::GetSource(const int iChannelUid)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create channel container
+	SQLRecord sqlChannel;
+	
+	// return host of channel stream (channels without one share a source)
+	if (!this->FindRecord("Channels", "iUniqueId", iChannelUid, sqlChannel))
+		return "";
+	
+	return ParseHost(ParseSQLValue(sqlChannel.GetRecord(), "<strStreamURL>", ""));
+}
+
+bool SQLConnection::AdmitTimer(DVRTimer& cTimer, vector<DVRTimer>& cTimers)
+{
+	// log function call
+	CPPLog(); 
+	
+	// get recording limits (zero is unlimited)
+	int iMaxRecords = settings->GetMaxRecords();
+	int iMaxStreams = settings->GetMaxStreams();
+	
+	if (iMaxRecords <= 0 && iMaxStreams <= 0)
+		return true;
+	
+	// get source of timer
+	string strSource = iMaxStreams > 0 ? GetSource(cTimer.GetClientChannelUid()) : "";
+	
+	// get sources of active recordings (looked up once when each recording started)
+	map<unsigned int, string> strSources;
+	
+	for (vector<SQLTask>::iterator sqlTask = sqlTasks.begin(); sqlTask != sqlTasks.end(); sqlTask++)
+		strSources[sqlTask->iClientIndex] = sqlTask->strSource;
+	
+	// count active recordings overall and on same source, keeping lowest priority of each
+	int       iRecords = 0   ;
+	int       iStreams = 0   ;
+	DVRTimer *pRecord  = NULL;
+	DVRTimer *pStream  = NULL;
+	
+	for (vector<DVRTimer>::iterator cRecord = cTimers.begin(); cRecord != cTimers.end(); cRecord++)
+	{
+		// only look for active recordings
+		if (cRecord->GetState() != PVR_TIMER_STATE_RECORDING)
+			continue;
+		
+		iRecords++;
+		
+		if (pRecord == NULL || cRecord->GetPriority() < pRecord->GetPriority())
+			pRecord = &(*cRecord);
+		
+		// only look for recordings on same source (channel looked up only if recording has no task)
+		if (iMaxStreams <= 0)
+			continue;
+		
+		map<unsigned int, string>::iterator strRecordSource = strSources.find(cRecord->GetClientIndex());
+		
+		if ((strRecordSource != strSources.end() ? strRecordSource->second : GetSource(cRecord->GetClientChannelUid())) != strSource)
+			continue;
+		
+		iStreams++;
+		
+		if (pStream == NULL || cRecord->GetPriority() < pStream->GetPriority())
+			pStream = &(*cRecord);
+	}
+	
+	// admit if both budgets have room
+	bool bRecordsFull = iMaxRecords > 0 && iRecords >= iMaxRecords;
+	bool bStreamsFull = iMaxStreams > 0 && iStreams >= iMaxStreams;
+	
+	if (!bRecordsFull && !bStreamsFull)
+		return true;
+	
+	// pick recording to preempt (same source frees both budgets, any source only frees overall)
+	DVRTimer *pPreempt = bStreamsFull ? pStream : pRecord;
+	
+	// preempt if lower priority than timer
+	if (pPreempt != NULL && pPreempt->GetPriority() < cTimer.GetPriority())
+	{
+		// log preemption
+		XBMC->Log(LOG_NOTICE, "C+: %s - Preempting %s recording (%i) for %s timer (%i)", __FUNCTION__, pPreempt->GetTitle(), pPreempt->GetClientIndex(), cTimer.GetTitle(), cTimer.GetClientIndex());
+		
+		// stop as aborted
+		this->StopTimer(pPreempt->Timer(), PVR_TIMER_STATE_ABORTED);
+		
+		// mark loaded copy too (later admissions in same pass no longer count it)
+		pPreempt->SetState(PVR_TIMER_STATE_ABORTED);
+		
+		return true;
+	}
+	
+	// log conflict
+	XBMC->Log(LOG_NOTICE, "C+: %s - No recording slot for %s timer (%i), %i of %i recordings, %i of %i on %s", __FUNCTION__, cTimer.GetTitle(), cTimer.GetClientIndex(), iRecords, iMaxRecords, iStreams, iMaxStreams, strSource.c_str());
+	
+	// return conflict
+	return false;
+}
+
 /***********************************************************
  * Create Tables Definitions
  ***********************************************************/
@@ -1036,127 +2155,745 @@ bool SQLConnection::CreateRecordings(void)
 	return (iResponse == SQLITE_OK);
 }
 
-/***********************************************************
- * Clear & Clear Tables Definitions
- ***********************************************************/
-void SQLConnection::ClearChannels(void)
+/***********************************************************
+ * Schema Migration Definitions
+ ***********************************************************/
+bool SQLConnection::CreateSchemaVersion(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create query container
+	string strQuery;
+	int    iResponse;
+	
+	// create schema version table syntax (exists check for databases created before versioning)
+	strQuery = string("CREATE TABLE IF NOT EXISTS SchemaVersion(") +
+			   string("iVersion INT PRIMARY KEY NOT NULL       ,") + 
+			   string("iModTime INT                            )") ;
+
+	// send query to create schema version table
+	iResponse = SendQuery(strQuery.c_str(), NULL);
+	
+	// return value
+	return (iResponse == SQLITE_OK);
+}
+
+int SQLConnection::GetSchemaVersion(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create return value (empty table is version 0)
+	int iVersion = 0;
+	
+	// fetch compiled query for version
+	sqlite3_stmt *sqlQuery = PrepareQuery("SELECT MAX(iVersion) FROM SchemaVersion");
+	
+	// call query and read version directly
+	if (sqlQuery)
+	{
+		if (sqlite3_step(sqlQuery) == SQLITE_ROW)
+			iVersion = sqlite3_column_int(sqlQuery, 0);
+		
+		// release statement
+		sqlite3_reset(sqlQuery);
+	}
+	
+	// return version
+	return iVersion;
+}
+
+bool SQLConnection::ApplyMigration(const int iVersion, const vector<string>& strQueries)
+{
+	// log function call
+	CPPLog(); 
+	
+	// skip if already applied
+	if (GetSchemaVersion() >= iVersion)
+		return true;
+	
+	// log migration
+	XBMC->Log(LOG_NOTICE, "C+: %s - Migrating SQL database to schema version %i", __FUNCTION__, iVersion);
+	
+	// create local containers
+	int iResponse = SendQuery("BEGIN TRANSACTION", NULL);
+	
+	// apply changes in order
+	for (vector<string>::const_iterator strQuery = strQueries.begin(); strQuery != strQueries.end() && iResponse == SQLITE_OK; strQuery++)
+		iResponse = SendQuery(strQuery->c_str(), NULL);
+	
+	// record version with changes
+	if (iResponse == SQLITE_OK)
+		iResponse = SendQuery((string("INSERT INTO SchemaVersion VALUES (") + itos(iVersion) + string(", ") + itos(time(NULL)) + string(")")).c_str(), NULL);
+	
+	// commit or roll back as one
+	if (iResponse == SQLITE_OK)
+		iResponse = SendQuery("COMMIT"  , NULL);
+	else
+		            SendQuery("ROLLBACK", NULL);
+	
+	// log failure
+	if (iResponse != SQLITE_OK)
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to migrate SQL database to schema version %i", __FUNCTION__, iVersion);
+	
+	// return value
+	return (iResponse == SQLITE_OK);
+}
+
+bool SQLConnection::MigrateSchema(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// make sure version table exists
+	if (!CreateSchemaVersion())
+		return false;
+	
+	// migrations are applied in order and never edited once released, add new changes as a new version
+	
+	// version 1: secondary indexes for guide and timer lookups (primary key already covers EpgChannels.strTvgId, EpgEntries is rekeyed on strTvgId and startTime in version 3)
+	if (!ApplyMigration(1, {"CREATE INDEX IF NOT EXISTS idxEpgChannelsTvgName ON EpgChannels(strTvgName)         ",
+	                        "CREATE INDEX IF NOT EXISTS idxEpgEntriesTvgId    ON EpgEntries (strTvgId, startTime)",
+	                        "CREATE INDEX IF NOT EXISTS idxTimersState        ON Timers     (state)              ",
+	                        "CREATE INDEX IF NOT EXISTS idxTimersParent       ON Timers     (iParentClientIndex) "}))
+		return false;
+	
+	// version 2: row change journal filled by triggers on tables changed in place (swapped tables journal a reset)
+	vector<string> strJournal = {"CREATE TABLE IF NOT EXISTS Journal(iSequence INTEGER PRIMARY KEY AUTOINCREMENT, strTable VARCHAR NOT NULL, strKey VARCHAR NOT NULL, iAction INT NOT NULL, iModTime INT NOT NULL)",
+	                             "CREATE INDEX IF NOT EXISTS idxJournalTable ON Journal(strTable, iSequence)",
+	                             "CREATE INDEX IF NOT EXISTS idxJournalKey   ON Journal(strTable, strKey   )"};
+	
+	vector<pair<string, string>> strJournaled = {{"Channels", "iUniqueId"}, {"TimerTypes", "iId"}, {"Timers", "iClientIndex"}, {"Recordings", "strRecordingId"}};
+	
+	for (vector<pair<string, string>>::iterator strTable = strJournaled.begin(); strTable != strJournaled.end(); strTable++)
+	{
+		strJournal.push_back(string("CREATE TRIGGER IF NOT EXISTS trg") + strTable->first + string("Insert AFTER INSERT ON ") + strTable->first + string(" BEGIN INSERT INTO Journal (strTable, strKey, iAction, iModTime) VALUES ('") + strTable->first + string("', NEW.") + strTable->second + string(", ") + itos(SQL_JOURNAL_INSERT) + string(", strftime('%s', 'now')); END"));
+		strJournal.push_back(string("CREATE TRIGGER IF NOT EXISTS trg") + strTable->first + string("Update AFTER UPDATE ON ") + strTable->first + string(" BEGIN INSERT INTO Journal (strTable, strKey, iAction, iModTime) VALUES ('") + strTable->first + string("', NEW.") + strTable->second + string(", ") + itos(SQL_JOURNAL_UPDATE) + string(", strftime('%s', 'now')); END"));
+		strJournal.push_back(string("CREATE TRIGGER IF NOT EXISTS trg") + strTable->first + string("Delete AFTER DELETE ON ") + strTable->first + string(" BEGIN INSERT INTO Journal (strTable, strKey, iAction, iModTime) VALUES ('") + strTable->first + string("', OLD.") + strTable->second + string(", ") + itos(SQL_JOURNAL_DELETE) + string(", strftime('%s', 'now')); END"));
+	}
+	
+	if (!ApplyMigration(2, strJournal))
+		return false;
+	
+	// version 3: guide entries keyed on tvg id and start so refreshes update rows in place (covers idxEpgEntriesTvgId, times stored as integers for range queries, first import rewrites channel ids)
+	if (!ApplyMigration(3, {string("CREATE TABLE EpgEntriesKeyed(                                                             ") +
+	                        string("           iUniqueBroadcastId  INT                                               NOT NULL,") + 
+	                        string("           iUniqueChannelId    INT                                               NOT NULL,") + 
+	                        string("           strTitle            VARCHAR                                                   ,") + 
+	                        string("           startTime           INT                                               NOT NULL,") + 
+	                        string("           endTime             INT                                                       ,") + 
+	                        string("           strPlotOutline      VARCHAR                                                   ,") + 
+	                        string("           strPlot             VARCHAR                                                   ,") + 
+	                        string("           strOriginalTitle    VARCHAR                                                   ,") + 
+	                        string("           strCast             VARCHAR                                                   ,") + 
+	                        string("           strDirector         VARCHAR                                                   ,") + 
+	                        string("           strWriter           VARCHAR                                                   ,") + 
+	                        string("           iYear               INT                                                       ,") + 
+	                        string("           strIMDBNumber       VARCHAR                                                   ,") + 
+	                        string("           strIconPath         VARCHAR                                                   ,") + 
+	                        string("           iGenreType          INT                                                       ,") + 
+	                        string("           iGenreSubType       INT                                                       ,") + 
+	                        string("           strGenreDescription VARCHAR                                                   ,") + 
+	                        string("           firstAired          VARCHAR                                                   ,") + 
+	                        string("           iParentalRating     INT                                                       ,") + 
+	                        string("           iStarRating         INT                                                       ,") + 
+	                        string("           bNotify             VARCHAR                                                   ,") + 
+	                        string("           iSeriesNumber       INT                                                       ,") + 
+	                        string("           iEpisodeNumber      INT                                                       ,") + 
+	                        string("           iEpisodePartNumber  INT                                                       ,") + 
+	                        string("           strEpisodeName      VARCHAR                                                   ,") + 
+	                        string("           iFlags              INT                                                       ,") + 
+	                        string("           strSeriesLink       VARCHAR                                                   ,") + 
+	                        string("           strTvgId            VARCHAR                                           NOT NULL,") + 
+	                        string("CONSTRAINT sqlGuideId                  PRIMARY KEY (strTvgId, startTime)                  )") ,
+	                        "INSERT OR IGNORE INTO EpgEntriesKeyed SELECT * FROM EpgEntries WHERE strTvgId IS NOT NULL AND startTime IS NOT NULL",
+	                        "DROP TABLE EpgEntries",
+	                        "ALTER TABLE EpgEntriesKeyed RENAME TO EpgEntries"}))
+		return false;
+	
+	// version 4: last imported content of each source (unchanged sources skip import)
+	if (!ApplyMigration(4, {"CREATE TABLE IF NOT EXISTS Sources(strUrl VARCHAR PRIMARY KEY NOT NULL, strHash VARCHAR NOT NULL DEFAULT '', strETag VARCHAR NOT NULL DEFAULT '', strLastModified VARCHAR NOT NULL DEFAULT '', iModTime INT NOT NULL)"}))
+		return false;
+	
+	// version 5: guide lookups for timer rules (title and series link per channel)
+	if (!ApplyMigration(5, {"CREATE INDEX IF NOT EXISTS idxEpgEntriesTitle      ON EpgEntries(strTvgId, strTitle     )",
+	                        "CREATE INDEX IF NOT EXISTS idxEpgEntriesSeriesLink ON EpgEntries(strTvgId, strSeriesLink)"}))
+		return false;
+	
+	// version 6: import settings of last import kept per source (not modified responses only trusted when settings match)
+	if (!ApplyMigration(6, {"ALTER TABLE Sources ADD COLUMN strSalt VARCHAR NOT NULL DEFAULT ''"}))
+		return false;
+	
+	// return value
+	return true;
+}
+
+/***********************************************************
+ * Clear & Clear Tables Definitions
+ ***********************************************************/
+void SQLConnection::ClearTimerTypes(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create query container
+	string strQuery;
+	
+	// create timer types clear syntax
+	strQuery = string("DELETE FROM TimerTypes") ;
+
+	// send query to clear timer types table
+	SendQuery(strQuery.c_str(), NULL);
+}
+
+void SQLConnection::CleanTimers(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create query container
+	string strQuery;
+	
+	// create timer types clear syntax
+	strQuery = string("DELETE FROM Timers WHERE state = ") + itos((int) PVR_TIMER_STATE_ABORTED) + " OR state = " + itos((int) PVR_TIMER_STATE_CANCELLED) + " OR state = " + itos((int) PVR_TIMER_STATE_COMPLETED);
+
+	// send query to clear timer types table
+	SendQuery(strQuery.c_str(), NULL);
+}
+
+void SQLConnection::CleanRecordings(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create query container
+	string strQuery;
+	
+	// create recording types clear syntax
+	strQuery = string("DELETE FROM Recordings WHERE bIsDeleted = '") + btos(true) + "'";
+
+	// send query to clear recording types table
+	SendQuery(strQuery.c_str(), NULL);
+}
+
+void SQLConnection::CleanEpgEntries(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock threads
+	SetLock();
+	
+	// fetch compiled query for entries ended before past horizon
+	sqlite3_stmt *sqlQuery = PrepareQuery("DELETE FROM EpgEntries WHERE endTime < ?");
+	
+	// bind horizon and drop entries
+	if (sqlQuery)
+	{
+		BindQuery(sqlQuery, {(long long)(time(NULL) - settings->GetEPGPastDays()*SECONDS_IN_DAY)});
+		
+		// log prune
+		if (StepQuery(sqlQuery, NULL) == SQLITE_OK && sqlite3_changes(sqlDatabase))
+			XBMC->Log(LOG_NOTICE, "C+: %s - Pruned %i guide entries past horizon", __FUNCTION__, sqlite3_changes(sqlDatabase));
+	}
+	
+	// get clean time
+	tLastEPGClean = time(NULL);
+	
+	// unlock threads
+	SetUnlock();
+}
+
+/***********************************************************
+ * Staging Tables Definitions
+ ***********************************************************/
+bool SQLConnection::CreateStaging(const vector<string>& strTables)
+{
+	// log function call
+	CPPLog(); 
+	
+	// remove copies left by an interrupted import
+	DropStaging(strTables);
+	
+	// lock threads
+	SetLock();
+	
+	// create local containers
+	int iResponse = SQLITE_OK;
+	
+	// copy each table definition (keys and constraints included, indexes are built at swap)
+	for (vector<string>::const_iterator strTable = strTables.begin(); strTable != strTables.end() && iResponse == SQLITE_OK; strTable++)
+	{
+		// fetch compiled query for table definition
+		sqlite3_stmt *sqlQuery = PrepareQuery("SELECT sql FROM sqlite_master WHERE type = 'table' AND name = ?");
+		
+		// create container for definition
+		string strSyntax;
+		
+		// bind table and read definition directly
+		if (sqlQuery)
+		{
+			BindQuery(sqlQuery, {*strTable});
+			
+			if (sqlite3_step(sqlQuery) == SQLITE_ROW)
+				strSyntax = (const char*)sqlite3_column_text(sqlQuery, 0);
+			
+			// release statement
+			sqlite3_reset(sqlQuery);
+		}
+		
+		// replace table name (stored name may be quoted after a rename)
+		if (strSyntax.find("(") != string::npos)
+			iResponse = SendQuery((string("CREATE TABLE ") + *strTable + string(DATABASE_STAGING) + strSyntax.substr(strSyntax.find("("))).c_str(), NULL);
+		else
+			iResponse = SQLITE_ERROR;
+	}
+	
+	// unlock threads
+	SetUnlock();
+	
+	// log failure
+	if (iResponse != SQLITE_OK)
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to create SQL staging tables", __FUNCTION__);
+	
+	// return value
+	return (iResponse == SQLITE_OK);
+}
+
+bool SQLConnection::SwapStaging(const vector<string>& strTables)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock threads
+	SetLock();
+	
+	// create local containers
+	int            iResponse = SendQuery("BEGIN TRANSACTION", NULL);
+	vector<string> strIndexes;
+	
+	// replace each table with its copy (readers keep the old snapshot until commit)
+	for (vector<string>::const_iterator strTable = strTables.begin(); strTable != strTables.end() && iResponse == SQLITE_OK; strTable++)
+	{
+		// fetch compiled query for index and trigger definitions
+		sqlite3_stmt *sqlQuery = PrepareQuery("SELECT sql FROM sqlite_master WHERE type IN ('index', 'trigger') AND tbl_name = ? AND sql IS NOT NULL");
+		
+		// clear container
+		strIndexes.clear();
+		
+		// bind table and read definitions directly
+		if (sqlQuery)
+		{
+			BindQuery(sqlQuery, {*strTable});
+			
+			while (sqlite3_step(sqlQuery) == SQLITE_ROW)
+				strIndexes.push_back((const char*)sqlite3_column_text(sqlQuery, 0));
+			
+			// release statement
+			sqlite3_reset(sqlQuery);
+		}
+		
+		// drop current table with its indexes and triggers
+		iResponse = SendQuery((string("DROP TABLE ") + *strTable).c_str(), NULL);
+		
+		// rename copy into place
+		if (iResponse == SQLITE_OK)
+			iResponse = SendQuery((string("ALTER TABLE ") + *strTable + string(DATABASE_STAGING) + string(" RENAME TO ") + *strTable).c_str(), NULL);
+		
+		// build indexes once on the full table and restore triggers
+		for (vector<string>::iterator strIndex = strIndexes.begin(); strIndex != strIndexes.end() && iResponse == SQLITE_OK; strIndex++)
+			iResponse = SendQuery(strIndex->c_str(), NULL);
+		
+		// journal swap as one reset (no row entries for the bulk copy)
+		if (iResponse == SQLITE_OK)
+			iResponse = ResetJournal(strTable->c_str());
+	}
+	
+	// commit or roll back as one
+	if (iResponse == SQLITE_OK)
+		iResponse = SendQuery("COMMIT"  , NULL);
+	else
+		            SendQuery("ROLLBACK", NULL);
+	
+	// update change log once per table
+	if (iResponse == SQLITE_OK)
+		for (vector<string>::const_iterator strTable = strTables.begin(); strTable != strTables.end(); strTable++)
+			UpdateDBLog(strTable->c_str());
+	
+	// unlock threads
+	SetUnlock();
+	
+	// log failure and drop copies (current tables kept)
+	if (iResponse != SQLITE_OK)
+	{
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to swap SQL staging tables", __FUNCTION__);
+		DropStaging(strTables);
+	}
+	
+	// return value
+	return (iResponse == SQLITE_OK);
+}
+
+bool SQLConnection::MergeStaging(const vector<string>& strTables)
+{
+	// log function call
+	CPPLog(); 
+	
+	// lock threads
+	SetLock();
+	
+	// create local containers
+	int         iResponse = SendQuery("BEGIN TRANSACTION", NULL);
+	vector<int> iChanges  ;
+	
+	// apply differences of each copy to its table (unchanged rows are left alone so triggers only journal real changes)
+	for (vector<string>::const_iterator strTable = strTables.begin(); strTable != strTables.end() && iResponse == SQLITE_OK; strTable++)
+	{
+		// fetch compiled query for column and key definitions
+		sqlite3_stmt *sqlQuery = PrepareQuery("SELECT name, pk FROM pragma_table_info(?) ORDER BY cid");
+		
+		// create containers for columns, copied values, and key
+		string strColumns ;
+		string strExcluded;
+		string strKey     ;
+		int    iChanged   = 0;
+		
+		// bind table and read definitions directly
+		if (sqlQuery)
+		{
+			BindQuery(sqlQuery, {*strTable});
+			
+			while (sqlite3_step(sqlQuery) == SQLITE_ROW)
+			{
+				// get column name
+				string strColumn = (const char*)sqlite3_column_text(sqlQuery, 0);
+				
+				// append to lists
+				strColumns  += (strColumns.empty()  ? string("") : string(", ")) +                      strColumn;
+				strExcluded += (strExcluded.empty() ? string("") : string(", ")) + string("excluded.") + strColumn;
+				
+				// append key columns
+				if (sqlite3_column_int(sqlQuery, 1))
+					strKey += (strKey.empty() ? string("") : string(", ")) + strColumn;
+			}
+			
+			// release statement
+			sqlite3_reset(sqlQuery);
+		}
+		
+		// tables without key cannot be compared row by row
+		if (strKey.empty())
+			iResponse = SQLITE_ERROR;
+		
+		// drop rows no longer listed
+		if (iResponse == SQLITE_OK)
+			iResponse = SendQuery((string("DELETE FROM ") + *strTable + string(" WHERE (") + strKey + string(") NOT IN (SELECT ") + strKey + string(" FROM ") + *strTable + string(DATABASE_STAGING) + string(")")).c_str(), NULL);
+		
+		// count rows removed (trigger journal rows not counted)
+		if (iResponse == SQLITE_OK)
+			iChanged += sqlite3_changes(sqlDatabase);
+		
+		// add new rows and rewrite rows that differ
+		if (iResponse == SQLITE_OK)
+			iResponse = SendQuery((string("INSERT INTO ") + *strTable + string(" (") + strColumns + string(") SELECT ") + strColumns + string(" FROM ") + *strTable + string(DATABASE_STAGING) + string(" WHERE true") +
+			                       string(" ON CONFLICT (") + strKey + string(") DO UPDATE SET (") + strColumns + string(") = (") + strExcluded + string(") WHERE (") + strColumns + string(") IS NOT (") + strExcluded + string(")")).c_str(), NULL);
+		
+		// count rows added or rewritten
+		if (iResponse == SQLITE_OK)
+			iChanged += sqlite3_changes(sqlDatabase);
+		
+		// journal changes to tables without row triggers as one reset
+		for (vector<SQLMsg>::iterator sqlMsg = sqlLog.begin(); sqlMsg != sqlLog.end() && iResponse == SQLITE_OK && iChanged; sqlMsg++)
+			if (*strTable == sqlMsg->strTable && sqlMsg->strKey.empty())
+				iResponse = ResetJournal(strTable->c_str());
+		
+		// drop copy
+		if (iResponse == SQLITE_OK)
+			iResponse = SendQuery((string("DROP TABLE ") + *strTable + string(DATABASE_STAGING)).c_str(), NULL);
+		
+		// keep count for change log
+		iChanges.push_back(iChanged);
+	}
+	
+	// commit or roll back as one
+	if (iResponse == SQLITE_OK)
+		iResponse = SendQuery("COMMIT"  , NULL);
+	else
+		            SendQuery("ROLLBACK", NULL);
+	
+	// update change log only for tables that changed
+	if (iResponse == SQLITE_OK)
+	{
+		for (size_t i = 0; i < strTables.size(); i++)
+		{
+			// skip identical tables
+			if (!iChanges[i])
+				continue;
+			
+			// log changes
+			XBMC->Log(LOG_NOTICE, "C+: %s - %i row(s) changed in table [%s]", __FUNCTION__, iChanges[i], strTables[i].c_str());
+			
+			// update change log
+			UpdateDBLog(strTables[i].c_str());
+		}
+	}
+	
+	// unlock threads
+	SetUnlock();
+	
+	// log failure and drop copies (current tables kept)
+	if (iResponse != SQLITE_OK)
+	{
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to merge SQL staging tables", __FUNCTION__);
+		DropStaging(strTables);
+	}
+	
+	// return value
+	return (iResponse == SQLITE_OK);
+}
+
+void SQLConnection::DropStaging(const vector<string>& strTables)
 {
 	// log function call
 	CPPLog(); 
 	
-	// create query container
-	string strQuery;
+	// lock threads
+	SetLock();
 	
-	// create channels clear syntax
-	strQuery = string("DELETE FROM Channels") ;
-
-	// send query to clear channels table
-	SendQuery(strQuery.c_str(), NULL);
+	// drop copies if present
+	for (vector<string>::const_iterator strTable = strTables.begin(); strTable != strTables.end(); strTable++)
+		SendQuery((string("DROP TABLE IF EXISTS ") + *strTable + string(DATABASE_STAGING)).c_str(), NULL);
+	
+	// unlock threads
+	SetUnlock();
 }
 
-void SQLConnection::ClearChannelGroups(void)
+/***********************************************************
+ * Source Cache Definitions
+ ***********************************************************/
+bool SQLConnection::FetchSource(const string strUrl, const bool bCache, const string strSalt, string& strPath, SQLSource& sqlSource)
 {
 	// log function call
 	CPPLog(); 
 	
-	// create query container
-	string strQuery;
+	// read source directly unless cached
+	strPath = strUrl;
 	
-	// create channel groups clear syntax
-	strQuery = string("DELETE FROM ChannelGroups") ;
-
-	// send query to clear channel groups table
-	SendQuery(strQuery.c_str(), NULL);
-}
-
-void SQLConnection::ClearChannelGroupMembers(void)
-{
-	// log function call
-	CPPLog(); 
+	// clear source
+	sqlSource.strUrl          = strUrl ;
+	sqlSource.strSalt         = strSalt;
+	sqlSource.strHash         = ""     ;
+	sqlSource.strETag         = ""    ;
+	sqlSource.strLastModified = ""    ;
 	
-	// create query container
-	string strQuery;
+	// check if remote source (local files are hashed in place, remote files are copied to cache as hashed)
+	bool bRemote = StringUtils::StartsWithNoCase(strUrl, "http://") || StringUtils::StartsWithNoCase(strUrl, "https://");
 	
-	// create channel group members clear syntax
-	strQuery = string("DELETE FROM ChannelGroupMembers") ;
-
-	// send query to clear channel group members table
-	SendQuery(strQuery.c_str(), NULL);
-}
-
-void SQLConnection::ClearGuideChannels(void)
-{
-	// log function call
-	CPPLog(); 
+	// import remote source directly if cache disabled
+	if (bRemote && !bCache)
+		return true;
 	
-	// create query container
-	string strQuery;
+	// create containers for hash and import settings of last import
+	string strLastHash;
+	string strLastSalt;
 	
-	// create guide channels clear syntax
-	strQuery = string("DELETE FROM EpgChannels") ;
-
-	// send query to clear guide channels table
-	SendQuery(strQuery.c_str(), NULL);
-}
-
-void SQLConnection::ClearGuideEntries(void)
-{
-	// log function call
-	CPPLog(); 
+	// lock threads
+	SetLock();
 	
-	// create query container
-	string strQuery;
+	// fetch compiled query for last import of source
+	sqlite3_stmt *sqlQuery = PrepareQuery("SELECT strHash, strETag, strLastModified, strSalt FROM Sources WHERE strUrl = ?");
 	
-	// create guide clear syntax
-	strQuery = string("DELETE FROM EpgEntries") ;
-
-	// send query to clear guide table
-	SendQuery(strQuery.c_str(), NULL);
-}
-
-void SQLConnection::ClearTimerTypes(void)
-{
-	// log function call
-	CPPLog(); 
+	// bind url and read last import directly
+	if (sqlQuery)
+	{
+		BindQuery(sqlQuery, {strUrl});
+		
+		if (sqlite3_step(sqlQuery) == SQLITE_ROW)
+		{
+			strLastHash               = (const char*)sqlite3_column_text(sqlQuery, 0);
+			sqlSource.strETag         = (const char*)sqlite3_column_text(sqlQuery, 1);
+			sqlSource.strLastModified = (const char*)sqlite3_column_text(sqlQuery, 2);
+			strLastSalt               = (const char*)sqlite3_column_text(sqlQuery, 3);
+		}
+		
+		// release statement
+		sqlite3_reset(sqlQuery);
+	}
 	
-	// create query container
-	string strQuery;
+	// unlock threads
+	SetUnlock();
 	
-	// create timer types clear syntax
-	strQuery = string("DELETE FROM TimerTypes") ;
-
-	// send query to clear timer types table
-	SendQuery(strQuery.c_str(), NULL);
-}
-
-void SQLConnection::CleanTimers(void)
-{
-	// log function call
-	CPPLog(); 
+	// only ask server to skip body if last import used same settings (otherwise file is read again to import with new ones)
+	bool bConditional = !strLastHash.empty() && strLastSalt == strSalt;
 	
-	// create query container
-	string strQuery;
+	// create cache path (one copy per url)
+	string strCache = settings->GetUserPath() + SOURCE_CACHE_FOLDER + ParseFolderSeparator(settings->GetUserPath());
 	
-	// create timer types clear syntax
-	strQuery = string("DELETE FROM Timers WHERE state = ") + itos((int) PVR_TIMER_STATE_ABORTED) + " OR state = " + itos((int) PVR_TIMER_STATE_CANCELLED) + " OR state = " + itos((int) PVR_TIMER_STATE_COMPLETED);
-
-	// send query to clear timer types table
-	SendQuery(strQuery.c_str(), NULL);
+	// create directory if it doesn't exist
+	if (bRemote && !XBMC->DirectoryExists(strCache.c_str()))
+		XBMC->CreateDirectory(strCache.c_str());
+	
+	// add file name to directory
+	strCache += string("source") + itos(stoh(strUrl)) + string(".cache");
+	
+	// open source (remote asks server to skip body if unchanged since last import)
+	void *fileHandle = NULL;
+	
+	if (bRemote)
+	{
+		fileHandle = XBMC->CURLCreate(strUrl.c_str());
+		
+		if (fileHandle && bConditional && !sqlSource.strETag.empty())
+			XBMC->CURLAddOption(fileHandle, XFILE::CURL_OPTION_HEADER, "If-None-Match"    , sqlSource.strETag.c_str()        );
+		
+		if (fileHandle && bConditional && !sqlSource.strLastModified.empty())
+			XBMC->CURLAddOption(fileHandle, XFILE::CURL_OPTION_HEADER, "If-Modified-Since", sqlSource.strLastModified.c_str());
+		
+		if (fileHandle && !XBMC->CURLOpen(fileHandle, XFILE::READ_NO_CACHE))
+		{
+			XBMC->CloseFile(fileHandle);
+			fileHandle = NULL;
+		}
+	}
+	else
+	{
+		fileHandle = XBMC->OpenFile(strUrl.c_str(), 0);
+	}
+	
+	// import directly if source could not be opened (import logs issue)
+	if (!fileHandle)
+		return true;
+	
+	// read response validators
+	if (bRemote)
+	{
+		// check for not modified response
+		char *strValue     = XBMC->GetFilePropertyValue(fileHandle, XFILE::FILE_PROPERTY_RESPONSE_PROTOCOL, "");
+		bool  bNotModified = strValue && string(strValue).find(" 304") != string::npos;
+		
+		if (strValue)
+			XBMC->FreeString(strValue);
+		
+		// skip import if server reports no change (only asked when settings match last import)
+		if (bNotModified && bConditional)
+		{
+			// close source
+			XBMC->CloseFile(fileHandle);
+			
+			// log skip
+			XBMC->Log(LOG_NOTICE, "C+: %s - Source not modified since last import [%s], skipping import", __FUNCTION__, strUrl.c_str());
+			
+			// return no import
+			return false;
+		}
+		
+		// get entity tag
+		strValue          = XBMC->GetFilePropertyValue(fileHandle, XFILE::FILE_PROPERTY_RESPONSE_HEADER, "etag");
+		sqlSource.strETag = strValue ? strValue : "";
+		
+		if (strValue)
+			XBMC->FreeString(strValue);
+		
+		// get modified date
+		strValue                  = XBMC->GetFilePropertyValue(fileHandle, XFILE::FILE_PROPERTY_RESPONSE_HEADER, "last-modified");
+		sqlSource.strLastModified = strValue ? strValue : "";
+		
+		if (strValue)
+			XBMC->FreeString(strValue);
+	}
+	
+	// open cache copy for remote source
+	void *cacheHandle = bRemote ? XBMC->OpenFileForWrite(strCache.c_str(), true) : NULL;
+	
+	// create hash (fnv-1a, import settings first so a change in them imports again)
+	unsigned long long iHash = 14695981039346656037ULL;
+	
+	for (string::const_iterator chr = strSalt.begin(); chr != strSalt.end(); chr++)
+		iHash = (iHash ^ (unsigned char)*chr) * 1099511628211ULL;
+	
+	// hash content as it streams in (copy written alongside)
+	vector<char> strBlock(SOURCE_READ_SIZE);
+	ssize_t      iBytes  ;
+	
+	while ((iBytes = XBMC->ReadFile(fileHandle, &strBlock[0], SOURCE_READ_SIZE)) > 0)
+	{
+		// add block to hash
+		for (ssize_t i = 0; i < iBytes; i++)
+			iHash = (iHash ^ (unsigned char)strBlock[i]) * 1099511628211ULL;
+		
+		// add block to copy
+		if (cacheHandle)
+			XBMC->WriteFile(cacheHandle, &strBlock[0], iBytes);
+	}
+	
+	// close files
+	XBMC->CloseFile(fileHandle);
+	
+	if (cacheHandle)
+		XBMC->CloseFile(cacheHandle);
+	
+	// import directly if read failed (partial content is not trusted)
+	if (iBytes < 0)
+	{
+		// log issue
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to read source [%s], importing directly", __FUNCTION__, strUrl.c_str());
+		
+		// return import
+		return true;
+	}
+	
+	// keep hash as text
+	char strHash[17];
+	sprintf(strHash, "%016llx", iHash);
+	
+	sqlSource.strHash = strHash;
+	
+	// import from copy
+	if (cacheHandle)
+		strPath = strCache;
+	
+	// skip import if content matches last import
+	if (sqlSource.strHash == strLastHash)
+	{
+		// keep response validators
+		SaveSource(sqlSource);
+		
+		// log skip
+		XBMC->Log(LOG_NOTICE, "C+: %s - Source unchanged since last import [%s], skipping import", __FUNCTION__, strUrl.c_str());
+		
+		// return no import
+		return false;
+	}
+	
+	// return import
+	return true;
 }
 
-void SQLConnection::CleanRecordings(void)
+void SQLConnection::SaveSource(const SQLSource& sqlSource)
 {
 	// log function call
 	CPPLog(); 
 	
-	// create query container
-	string strQuery;
+	// nothing to keep if source was not hashed
+	if (sqlSource.strHash.empty())
+		return;
 	
-	// create recording types clear syntax
-	strQuery = string("DELETE FROM Recordings WHERE bIsDeleted = '") + btos(true) + "'";
-
-	// send query to clear recording types table
-	SendQuery(strQuery.c_str(), NULL);
+	// lock threads
+	SetLock();
+	
+	// fetch compiled query for source
+	sqlite3_stmt *sqlQuery = PrepareQuery("INSERT OR REPLACE INTO Sources (strUrl, strSalt, strHash, strETag, strLastModified, iModTime) VALUES (?, ?, ?, ?, ?, ?)");
+	
+	// bind values and call query
+	if (sqlQuery)
+	{
+		BindQuery(sqlQuery, {sqlSource.strUrl, sqlSource.strSalt, sqlSource.strHash, sqlSource.strETag, sqlSource.strLastModified, (long long)time(NULL)});
+		StepQuery(sqlQuery, NULL);
+	}
+	
+	// unlock threads
+	SetUnlock();
 }
 
 /***********************************************************
@@ -1167,11 +2904,25 @@ void SQLConnection::ImportM3U(void)
 	// log function call
 	CPPLog();
 
-	// open the M3U file via kodi
-	void *fileHandle = XBMC->OpenFile(settings->GetM3UPath().c_str(), 0);
+	// create containers for source and path read
+	SQLSource sqlSource;
+	string    strPath  ;
+	
+	// fetch through source cache (start number and logo path change imported rows)
+	if (!FetchSource(settings->GetM3UPath(), settings->GetM3UCache(), itos(settings->GetM3UStartNum()) + settings->GetLogoPath(), strPath, sqlSource))
+	{
+		// get read time of file
+		tLastM3URead = time(NULL);
+		
+		// return no issue
+		return;
+	}
+
+	// open the M3U file via kodi (read line by line, archives inflate as read)
+	GzipReader gzReader;
 
 	// check if file could be open otherwise return error
-	if (!fileHandle)
+	if (!gzReader.Open(strPath.c_str()))
 	{
 		// log issue
 		XBMC->Log(LOG_ERROR, "C+: %s - No M3U file found in path, skipping import", __FUNCTION__);
@@ -1180,27 +2931,17 @@ void SQLConnection::ImportM3U(void)
 		return;
 	}
 
-	// read in file to memory
-	char   buffer[1024];
-	string content     ;
-
-	while (int bytes = XBMC->ReadFile(fileHandle, buffer, 1024))
-	{
-		if (bytes) content.append(buffer, bytes);
-	}
-
-	// close file
-	XBMC->CloseFile(fileHandle);
+	// read first line
+	string strLine;
+	
+	gzReader.ReadLine(strLine);
 
 	// remove bad data from start of file if present
-	if (StringUtils::Left(content, 3) == "\xEF\xBB\xBF")
-		content.erase(0, 3);
-
-	// split into lines
-	vector<string> pLines = StringUtils::Split(content, "\n");
+	if (StringUtils::Left(strLine, 3) == "\xEF\xBB\xBF")
+		strLine.erase(0, 3);
 
 	// check if valid M3U file
-	if (!StringUtils::StartsWith(pLines[0], M3U_START_MARKER))
+	if (!StringUtils::StartsWith(strLine, M3U_START_MARKER))
 	{
 		// log issue
 		XBMC->Log(LOG_ERROR, "C+: %s - Not a valid M3U file, skipping import", __FUNCTION__);
@@ -1209,8 +2950,15 @@ void SQLConnection::ImportM3U(void)
 		return;
 	}
 
-	// create string list for groups
-	string channel_group_list;
+	// create staging tables (clients keep reading current tables, copies are merged in by difference)
+	const vector<string> strTables = {"Channels", "ChannelGroups", "ChannelGroupMembers"};
+	
+	if (!CreateStaging(strTables))
+		return;
+	
+	// create set for groups added (keyed by radio/tv and name)
+	unordered_set<string> strGroups;
+	string                strGroupKey;
 
 	// create containers for channels parsed text
 	int    iUniqueId         = PVR_CHANNEL_INVALID_UID     ;
@@ -1230,119 +2978,128 @@ void SQLConnection::ImportM3U(void)
 	string strTvgLogo        = ""                          ;
 	float  iTvgShift         = 0.0                         ;
 	
+	// create container for info line tokens
+	M3UInfo m3uInfo;
+	
 	// create containers for channel groups parsed text
 	int iPosition = 0;
 	
-	// start transaction
-	sqlite3_exec(sqlDatabase, "BEGIN TRANSACTION;", NULL, NULL, NULL);
-	
-	// go through the split lines
-	for (vector<string>::iterator pLine = pLines.begin()+1; pLine != pLines.end(); pLine++)
+	// create sql containers (compiled once, values bound per row)
+	const string sqlChannelGroup       = string("(strGroupName, bIsRadio, iPosition)"                                         ) +
+	                                     string(" VALUES (?, ?, ?)"                                                           ) ;
+	const string sqlChannelGroupMember = string("(strGroupName, iChannelUniqueId, iChannelNumber, iSubChannelNumber, bIsRadio)") +
+	                                     string(" VALUES (?, ?, ?, ?, ?)"                                                     ) ;
+	const string sqlChannel            = string("(iUniqueId     , bIsRadio      , iChannelNumber   , iSubChannelNumber   ,"   ) +
+	                                     string(" strChannelName, strInputFormat, iEncryptionSystem, strIconPath         ,"   ) +
+	                                     string(" bIsHidden     , strGroupName  , strStreamURL     , strTvgId            ,"   ) +
+	                                     string(" strTvgName    , strTvgLogo    , iTvgShift                              )"   ) +
+	                                     string(" VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"                       ) ;
+	
+	// create containers for rows waiting to be written (one transaction and one compiled query per batch)
+	vector<vector<SQLValue> > sqlGroupRows  ;
+	vector<vector<SQLValue> > sqlMemberRows ;
+	vector<vector<SQLValue> > sqlChannelRows;
+	
+	// read first line after header
+	bool bNext = gzReader.ReadLine(strLine);
+	
+	// go through the lines as they stream in
+	while (bNext)
 	{
-		// parse the M3U file
-		if (pLine->size() > 1)
+		// read lines until batch is full
+		for (; bNext && sqlChannelRows.size() < M3U_INSERT_BATCH; bNext = gzReader.ReadLine(strLine))
 		{
-			// point to line
-			string pLineNode = *pLine;
-
-			// read marker values
-			if (StringUtils::StartsWith(pLineNode, M3U_INFO_MARKER))
+			// skip lines with no content
+			if (strLine.size() <= 1)
+				continue;
+			
+			// read marker values in one pass (values point into line until copied below)
+			if (ParseM3UInfo(strLine, m3uInfo))
 			{
 				// get attributes from line
-				iUniqueId      =                           stoh(GetDisplayName    (pLineNode                                 ));
-				bIsRadio       =                           stob(ReadM3UMarkerValue(pLineNode, M3U_RADIO_MARKER     ,  "false"));
-				iChannelNumber++                                                                                               ;
-				iTvgChannelNo  =                           stoi(ReadM3UMarkerValue(pLineNode, TVG_INFO_CHNO_MARKER ,      "0"));
-				strChannelName =                                GetDisplayName    (pLineNode                                 ) ;
-				strIconPath    = settings->GetLogoPath() +      ReadM3UMarkerValue(pLineNode, TVG_INFO_LOGO_MARKER ,      "" ) ;
-				bIsHidden      =                           stob(ReadM3UMarkerValue(pLineNode, M3U_HIDDEN_MARKER    ,  "false"));
-				strGroupName   =                                ReadM3UMarkerValue(pLineNode, M3U_GROUP_NAME_MARKER,      "" ) ;
-				strTvgId       =                                ReadM3UMarkerValue(pLineNode, TVG_INFO_ID_MARKER   ,      "" ) ;
-				strTvgName     =                                ReadM3UMarkerValue(pLineNode, TVG_INFO_NAME_MARKER ,      "" ) ;
-				strTvgLogo     =                                ReadM3UMarkerValue(pLineNode, TVG_INFO_LOGO_MARKER ,      "" ) ;
-				iTvgShift      =                           stof(ReadM3UMarkerValue(pLineNode, TVG_INFO_SHIFT_MARKER,   "0.0" ));
+				strChannelName =                                GetM3UValue(m3uInfo.strName     ,      "" ) ;
+				iUniqueId      =                           stoh(strChannelName                               );
+				bIsRadio       =                           stob(GetM3UValue(m3uInfo.bIsRadio    ,  "false"));
+				iChannelNumber++                                                                              ;
+				iTvgChannelNo  =                           stoi(GetM3UValue(m3uInfo.strTvgChNo  ,      "0"));
+				strIconPath    = settings->GetLogoPath() +      GetM3UValue(m3uInfo.strTvgLogo  ,      "" ) ;
+				bIsHidden      =                           stob(GetM3UValue(m3uInfo.bIsHidden   ,  "false"));
+				strGroupName   =                                GetM3UValue(m3uInfo.strGroupName,      "" ) ;
+				strTvgId       =                                GetM3UValue(m3uInfo.strTvgId    ,      "" ) ;
+				strTvgName     =                                GetM3UValue(m3uInfo.strTvgName  ,      "" ) ;
+				strTvgLogo     =                                GetM3UValue(m3uInfo.strTvgLogo  ,      "" ) ;
+				iTvgShift      =                           stof(GetM3UValue(m3uInfo.strTvgShift ,   "0.0" ));
+				
+				// create key for group
+				strGroupKey = (bIsRadio ? string("Radio:") : string("TV:")) + strGroupName;
 				
-				// add channel group
-				if ((int)channel_group_list.find(((bIsRadio ? string("Radio:") : string("TV:")) + strGroupName).c_str()) < 0)
+				// add channel group if unique
+				if (strGroups.insert(strGroupKey).second)
 				{
-					// create sql ontainer
-					string sqlChannelGroup = string("(strGroupName, bIsRadio, iPosition   )") +
-					                         string(" VALUES ") +  
-					                         string("('") + StringUtils_Replace(    (strGroupName),"'", "''") + string("',") +
-											 string(" '") + StringUtils_Replace(btos(bIsRadio    ),"'", "''") + string("',") +
-											 string("  ") + StringUtils_Replace(itos(iPosition++ ),"'", "''") + string(" )") ;										
-					
-					// push to database
-					AddRecord("ChannelGroups", sqlChannelGroup);
+					// queue for database
+					sqlGroupRows.push_back({strGroupName, bIsRadio, iPosition++});
 	
 					// log addition
 					XBMC->Log(LOG_DEBUG, "C+: %s - Added channel group %s (%s)", __FUNCTION__, strGroupName.c_str(), (bIsRadio ? string("Radio") : string("TV")).c_str());
-
-					// add to list of groups
-					channel_group_list.append((string("{") + (bIsRadio ? string("Radio:") : string("TV:")) + strGroupName + string("}")).c_str());
 				}
 				
 				// add channel to group if present
 				if (strGroupName != "")
 				{				
-					// create sql ontainer
-					string sqlChannelGroupMember = string("(strGroupName, iChannelUniqueId, iChannelNumber, iSubChannelNumber, bIsRadio)") +
-					                               string(" VALUES ") +  
-					                               string("('") + StringUtils_Replace(    (strGroupName     ),"'", "''") + string("', ") +
-					                               string("  ") + StringUtils_Replace(itos(iUniqueId        ),"'", "''") + string(" , ") +
-					                               string("  ") + StringUtils_Replace(itos(iChannelNumber   ),"'", "''") + string(" , ") +
-					                               string("  ") + StringUtils_Replace(itos(iSubChannelNumber),"'", "''") + string(" , ") +
-					                               string(" '") + StringUtils_Replace(btos(bIsRadio         ),"'", "''") + string("') ") ;
-
-					// push to database
-					AddRecord("ChannelGroupMembers", sqlChannelGroupMember);
+					// queue for database
+					sqlMemberRows.push_back({strGroupName, iUniqueId, iChannelNumber, iSubChannelNumber, bIsRadio});
 	
 					// log addition
 					XBMC->Log(LOG_DEBUG, "C+: %s - Added to channel group %s (Ch#%i)", __FUNCTION__, strGroupName.c_str(), iChannelNumber);
 				}
 			}
-			else if (!StringUtils::StartsWith(pLineNode, M3U_START_MARKER))
+			else if (!StringUtils::StartsWith(strLine, M3U_START_MARKER))
 			{
 				// get url from line
-				strStreamURL = StringUtils::Trim(pLineNode);
+				strStreamURL = StringUtils::Trim(strLine);
 				
 				// add if url present
 				if (strStreamURL.substr(0, 1) != "" && strStreamURL.substr(0, 1) != "#")
 				{
-					// create sql ontainer
-					string sqlChannel  = string("(iUniqueId     , bIsRadio      , iChannelNumber   , iSubChannelNumber   ,") +
-					                     string(" strChannelName, strInputFormat, iEncryptionSystem, strIconPath         ,") +
-					                     string(" bIsHidden     , strGroupName  , strStreamURL     , strTvgId            ,") +
-					                     string(" strTvgName    , strTvgLogo    , iTvgShift                              )") +
-					                     string(" VALUES ") +  
-					                     string("( ") + StringUtils_Replace(itos(iUniqueId                                     ),"'", "''") + string(" , ") +
-					                     string(" '") + StringUtils_Replace(btos(bIsRadio                                      ),"'", "''") + string("', ") +
-					                     string("  ") + StringUtils_Replace(itos(iTvgChannelNo ? iTvgChannelNo : iChannelNumber),"'", "''") + string(" , ") +
-					                     string("  ") + StringUtils_Replace(itos(iSubChannelNumber                             ),"'", "''") + string(" , ") +
-					                     string(" '") + StringUtils_Replace(    (strChannelName                                ),"'", "''") + string("', ") +
-					                     string(" '") + StringUtils_Replace(    (strInputFormat                                ),"'", "''") + string("', ") +
-					                     string("  ") + StringUtils_Replace(itos(iEncryptionSystem                             ),"'", "''") + string(" , ") +
-					                     string(" '") + StringUtils_Replace(    (strIconPath                                   ),"'", "''") + string("', ") +
-					                     string(" '") + StringUtils_Replace(btos(bIsHidden                                     ),"'", "''") + string("', ") +
-					                     string(" '") + StringUtils_Replace(    (strGroupName                                  ),"'", "''") + string("', ") +
-					                     string(" '") + StringUtils_Replace(    (strStreamURL                                  ),"'", "''") + string("', ") +
-					                     string(" '") + StringUtils_Replace(    (strTvgId                                      ),"'", "''") + string("', ") +
-					                     string(" '") + StringUtils_Replace(    (strTvgName                                    ),"'", "''") + string("', ") +
-					                     string(" '") + StringUtils_Replace(    (strTvgLogo                                    ),"'", "''") + string("', ") +
-					                     string("  ") + StringUtils_Replace(ftos(iTvgShift                                     ),"'", "''") + string(" ) ") ;
-
-					// push to database
-					AddRecord("Channels", sqlChannel);
+					// queue for database
+					sqlChannelRows.push_back({iUniqueId     , bIsRadio      , iTvgChannelNo ? iTvgChannelNo : iChannelNumber, iSubChannelNumber,
+					                          strChannelName, strInputFormat, iEncryptionSystem                             , strIconPath      ,
+					                          bIsHidden     , strGroupName  , strStreamURL                                  , strTvgId         ,
+					                          strTvgName    , strTvgLogo    , iTvgShift                                                        });
 	
 					// log addition
 					XBMC->Log(LOG_DEBUG, "C+: %s - Added channel #%i (%s)", __FUNCTION__, iTvgChannelNo ? iTvgChannelNo : iChannelNumber, strChannelName.c_str());
 				}
 			}
 		}
+		
+		// push batch to database
+		AddRecords("ChannelGroups"       DATABASE_STAGING, sqlChannelGroup      , sqlGroupRows  );
+		AddRecords("ChannelGroupMembers" DATABASE_STAGING, sqlChannelGroupMember, sqlMemberRows );
+		AddRecords("Channels"            DATABASE_STAGING, sqlChannel           , sqlChannelRows);
+		
+		// clear batch (capacity kept for next)
+		sqlGroupRows  .clear();
+		sqlMemberRows .clear();
+		sqlChannelRows.clear();
 	}
 	
-	// end transaction
-	sqlite3_exec(sqlDatabase, "END TRANSACTION;", NULL, NULL, NULL);
+	// drop partial tables if archive was cut short or corrupt
+	if (gzReader.GetStatus() != Z_OK)
+	{
+		// log issue
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to decompress M3U file (%i), skipping import", __FUNCTION__, gzReader.GetStatus());
+		
+		// drop staging tables
+		DropStaging(strTables);
+		
+		// return error
+		return;
+	}
+	
+	// merge in complete tables (only changed rows touched, change log kept if playlist is identical)
+	if (!MergeStaging(strTables))
+		return;
 
 	// log channels imported
 	XBMC->Log(LOG_NOTICE, "C+: %s - %i channels imported", __FUNCTION__, GetTableSize("Channels"));
@@ -1353,6 +3110,9 @@ void SQLConnection::ImportM3U(void)
 	// log channel group members imported
 	XBMC->Log(LOG_NOTICE, "C+: %s - %i channel groups members imported", __FUNCTION__, GetTableSize("ChannelGroupMembers"));
 	
+	// keep source of import
+	SaveSource(sqlSource);
+	
 	// get read time of file
 	tLastM3URead = time(NULL);
 	
@@ -1365,11 +3125,49 @@ void SQLConnection::ImportXMLTV(void)
 	// log function call
 	CPPLog(); 
 
-	// open the EPG file via kodi
-	void *fileHandle = XBMC->OpenFile(settings->GetEPGPath().c_str(), 0);
+	// create containers for source and path read
+	SQLSource sqlSource;
+	string    strPath  ;
+	
+	// fetch through source cache (guide horizon changes imported rows, horizon moves each day so same file is imported again once a day)
+	if (!FetchSource(settings->GetEPGPath(), settings->GetEPGCache(), itos(settings->GetEPGPastDays()) + string(",") + itos(settings->GetEPGFutureDays()) + string(",") + itos((int)(time(NULL)/SECONDS_IN_DAY)), strPath, sqlSource))
+	{
+		// get read time of file
+		tLastEPGRead = time(NULL);
+		
+		// lock reader connection
+		SQLReader *sqlReader = LockReader();
+		
+		// fetch compiled query for span of stored guide
+		sqlite3_stmt *sqlQuery = PrepareQuery("SELECT MIN(startTime), MAX(endTime) FROM EpgEntries", sqlReader);
+		
+		// set number of epg days from stored guide (import skipped, guide kept as last imported)
+		if (sqlQuery)
+		{
+			if (sqlite3_step(sqlQuery) == SQLITE_ROW && sqlite3_column_type(sqlQuery, 0) != SQLITE_NULL)
+			{
+				time_t startEPG = (time_t)sqlite3_column_int64(sqlQuery, 0);
+				time_t endEPG   = (time_t)sqlite3_column_int64(sqlQuery, 1);
+				
+				iNumEPGDays = ceil((endEPG - startEPG)/SECONDS_IN_DAY);
+			}
+			
+			// release statement
+			sqlite3_reset(sqlQuery);
+		}
+		
+		// unlock reader connection
+		UnlockReader(sqlReader);
+		
+		// return no issue
+		return;
+	}
+
+	// open the EPG file via kodi (read block by block, one element held at a time)
+	XMLReader xmlReader;
 
 	// check if file could be open otherwise return error
-	if (!fileHandle)
+	if (!xmlReader.Open(strPath.c_str()))
 	{
 		// log issue
 		XBMC->Log(LOG_ERROR, "C+: %s - No XMLTV file found in EPG path, skipping import", __FUNCTION__);
@@ -1378,267 +3176,321 @@ void SQLConnection::ImportXMLTV(void)
 		return;
 	}
 
-	// read in file to memory
-	char   buffer[1024];
-	string content     ;
+	// read up to first element (root must come first)
+	bool bNext = xmlReader.Next();
 
-	while (int bytes = XBMC->ReadFile(fileHandle, buffer, 1024))
+	// check if valid EPG file
+	if (!xmlReader.IsValid())
 	{
-		if (bytes) content.append(buffer, bytes);
+		// log issue
+		XBMC->Log(LOG_ERROR, "C+: %s - Not a valid XMLTV file, skipping import", __FUNCTION__);
+
+		// return error
+		return;
 	}
+	
+	// create staging table for guide channels (entries are upserted in place, clients keep reading the last commit)
+	const vector<string> strTables = {"EpgChannels"};
+	
+	if (!CreateStaging(strTables))
+		return;
+	
+	// create containers for parsed text for epg channels
+	string strTvgId   = "";
+	string strTvgName = "";
+	string strTvgLogo = "";	
+	
+	// create containers to look for channel (filled by channel pass, no table scan per programme)
+	unordered_set<string> strTvgIds  ;
+	unordered_set<string> strTvgNames;
+	
+	// create sql container (compiled once, values bound per row)
+	const string sqlEpgChannel = string("(strTvgId, strTvgName, strTvgLogo)") +
+	                             string(" VALUES (?, ?, ?)"                 ) ;
+	
+	// create containers for epg days
+	time_t startEPG = time(NULL);
+	time_t endEPG   = time(NULL);
+	
+	// create containers for changed guide ids (clients only refresh their channels)
+	unordered_set<string> strChanged;
+	int                   iChanged  = 0;
+	
+	// create horizon (programmes outside are never asked for)
+	time_t startHorizon = time(NULL) - settings->GetEPGPastDays  ()*SECONDS_IN_DAY;
+	time_t endHorizon   = time(NULL) + settings->GetEPGFutureDays()*SECONDS_IN_DAY;
+
+	// create sql container (compiled once, values bound per row, existing programme only rewritten when a column differs)
+	const string sqlEpgColumns  = string("(         iUniqueBroadcastId ,          iUniqueChannelId   ,          strTitle        ,          startTime         ,          endTime       ,") +
+	                              string("          strPlotOutline     ,          strPlot            ,          strOriginalTitle,          strCast           ,          strDirector   ,") +
+	                              string("          strWriter          ,          iYear              ,          strIMDBNumber   ,          strIconPath       ,          iGenreType    ,") +
+	                              string("          iGenreSubType      ,          strGenreDescription,          firstAired      ,          iParentalRating   ,          iStarRating   ,") +
+	                              string("          bNotify            ,          iSeriesNumber      ,          iEpisodeNumber  ,          iEpisodePartNumber,          strEpisodeName,") +
+	                              string("          iFlags             ,          strSeriesLink      ,          strTvgId                                                          )") ;
+	const string sqlEpgExcluded = string("(excluded.iUniqueBroadcastId , excluded.iUniqueChannelId   , excluded.strTitle        , excluded.startTime         , excluded.endTime       ,") +
+	                              string(" excluded.strPlotOutline     , excluded.strPlot            , excluded.strOriginalTitle, excluded.strCast           , excluded.strDirector   ,") +
+	                              string(" excluded.strWriter          , excluded.iYear              , excluded.strIMDBNumber   , excluded.strIconPath       , excluded.iGenreType    ,") +
+	                              string(" excluded.iGenreSubType      , excluded.strGenreDescription, excluded.firstAired      , excluded.iParentalRating   , excluded.iStarRating   ,") +
+	                              string(" excluded.bNotify            , excluded.iSeriesNumber      , excluded.iEpisodeNumber  , excluded.iEpisodePartNumber, excluded.strEpisodeName,") +
+	                              string(" excluded.iFlags             , excluded.strSeriesLink      , excluded.strTvgId                                                          )") ;
+	const string sqlEpgEntry    = string("INSERT OR REPLACE INTO temp.EpgEntriesStaging ") + sqlEpgColumns + string(" VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
+	const string sqlEpgMerge    = string("INSERT INTO EpgEntries SELECT * FROM temp.EpgEntriesStaging WHERE true") +
+	                              string(" ON CONFLICT (strTvgId, startTime) DO UPDATE SET ") + sqlEpgColumns + string(" = ") + sqlEpgExcluded + string(" WHERE ") + sqlEpgColumns + string(" IS NOT ") + sqlEpgExcluded;
+	
+	// create sql containers for programmes new or changed and programmes missing from file (compared once file is read)
+	const string sqlEpgChanged  = string("SELECT strTvgId FROM (SELECT * FROM temp.EpgEntriesStaging EXCEPT SELECT * FROM EpgEntries)");
+	const string sqlEpgUnseen   = string(" NOT EXISTS (SELECT 1 FROM temp.EpgEntriesStaging sqlSeen WHERE sqlSeen.strTvgId = EpgEntries.strTvgId AND sqlSeen.startTime = EpgEntries.startTime)");
+	
+	// create container for guide channels waiting to be written (one transaction per batch)
+	vector<vector<SQLValue> > sqlChannelRows;
+	
+	// create decode containers (one batch read and one written while the batch between decodes)
+	vector<string   > strRead   ;
+	vector<string   > strDecode ;
+	vector<SQLEpgRow> sqlDecoded;
+	vector<SQLEpgRow> sqlWrite  ;
+	SQLDecodeQueue    sqlQueue  ;
+	vector<thread>    tWorkers  ;
+	
+	// lock threads
+	SetLock();
+	
+	// create empty copy of guide for programmes read (temporary database, so batches written never lock guide for readers or other writes)
+	SendQuery("DROP TABLE IF EXISTS temp.EpgEntriesStaging"                                         , NULL);
+	SendQuery("CREATE TEMP TABLE EpgEntriesStaging AS SELECT * FROM EpgEntries WHERE 0"           , NULL);
+	SendQuery("CREATE UNIQUE INDEX temp.idxEpgEntriesStaging ON EpgEntriesStaging(strTvgId, startTime)", NULL);
+	
+	// unlock threads
+	SetUnlock();
+
+	// start decode workers (kept until file is read)
+	StartDecode(sqlQueue, tWorkers);
+
+	// read in epg channels and entries as they stream in (channels come first in xmltv)
+	while (bNext || !strRead.empty() || !strDecode.empty())
+	{
+		// read elements until batch is full
+		for (; bNext && strRead.size() < XMLTV_DECODE_BATCH; bNext = xmlReader.Next())
+		{
+			// queue programmes for decode workers
+			if (xmlReader.GetName() == XMLTV_PROGRAM_MARKER)
+			{
+				strRead.push_back(xmlReader.GetElement());
+				continue;
+			}
+			
+			// get element (remaining elements are channels)
+			const xml_node<> *pNode = xmlReader.GetNode();
+			
+			// skip if not parsed
+			if (!pNode)
+				continue;
+			
+			// get attributes from xml node (ignore display name, pure tvg id)
+			strTvgId   = GetXMLAttributeValue     (pNode, XMLTV_CHANNEL_ID_MARKER ,                         "");
+			strTvgName =                                                                   EPG_CHANNEL_NO_NAME        ;
+			strTvgLogo = GetXMLChildAttributeValue(pNode, XMLTV_ICON_MARKER       , XMLTV_SOURCE_MARKER,    ""); 
+			
+			// skip entries with no tvg-id
+			if (strTvgId == "")
+				continue;
+			
+			// add unique
+			if (strTvgIds.insert(strTvgId).second)
+			{
+				// queue for database
+				sqlChannelRows.push_back({strTvgId, strTvgName, strTvgLogo});
+				
+				// keep name of row added
+				strTvgNames.insert(strTvgName);
+
+				// log addition
+				XBMC->Log(LOG_DEBUG, "C+: %s - Added guide channel %s (%s)", __FUNCTION__, strTvgId.c_str(), strTvgName.c_str());
+			}
+			
+			// go through display names and add
+			for (xml_node<> *pDisplayNameNode = pNode->first_node(XMLTV_CHANNEL_NAME_MARKER); pDisplayNameNode; pDisplayNameNode = pDisplayNameNode->next_sibling(XMLTV_CHANNEL_NAME_MARKER))
+			{
+				// get attributes from xml node (ignore display name, pure tvg id)
+				strTvgName = pDisplayNameNode->value();
+				
+				// add unique
+				if (strTvgNames.insert(strTvgName).second)
+				{
+					// queue for database
+					sqlChannelRows.push_back({strTvgId, strTvgName, strTvgLogo});
 
-	// close file
-	XBMC->CloseFile(fileHandle);
-	
-	// check if a compressed archive
-	if (StringUtils::Left(content, 3) == "\x1F\x8B\x08")
-	{
-		// create container cor decompression
-		string decompressed;
+					// log addition
+					XBMC->Log(LOG_DEBUG, "C+: %s - Added guide channel %s (%s)", __FUNCTION__, strTvgId.c_str(), strTvgName.c_str());
+				}			
+			}
+		}
 		
-		// attempt to decompress using zlib
-		if (!GzipInflate(content, decompressed))
+		// push guide channels of batch to database
+		AddRecords("EpgChannels" DATABASE_STAGING, sqlEpgChannel, sqlChannelRows);
+		sqlChannelRows.clear();
+		
+		// wait for previous batch
+		WaitDecode(sqlQueue);
+		
+		// take decoded rows for writing
+		sqlWrite.swap(sqlDecoded);
+		
+		// hand read batch to workers
+		strDecode.swap(strRead);
+		strRead.clear();
+		
+		if (!strDecode.empty())
+			QueueDecode(sqlQueue, &strDecode, &sqlDecoded);
+		
+		// start transaction (one per batch, writer lock only held while batch is written)
+		if (!sqlWrite.empty())
+			BeginTransaction();
+		
+		// fetch compiled query for programme
+		sqlite3_stmt *sqlQuery = sqlWrite.empty() ? NULL : PrepareQuery(sqlEpgEntry);
+		
+		// write decoded rows in file order while next batch decodes and reads
+		for (vector<SQLEpgRow>::iterator sqlEntry = sqlWrite.begin(); sqlEntry != sqlWrite.end(); sqlEntry++)
 		{
-			XBMC->Log(LOG_ERROR, "C+: %s - Invalid EPG file unable to decompress file (%s)", __FUNCTION__, settings->GetEPGPath().c_str());
-			return;
+			// skip programmes that failed to decode
+			if (!sqlEntry->bIsValid)
+				continue;
+			
+			// look for channel in lookup table (skip if not found)
+			if (strTvgIds.find(sqlEntry->strTvgId) == strTvgIds.end())
+				continue;
+			
+			// skip programmes outside horizon
+			if (sqlEntry->endTime < startHorizon || sqlEntry->startTime > endHorizon)
+				continue;
+			
+			// push to staging copy (later duplicate of a key replaces earlier)
+			if (sqlQuery)
+			{
+				BindQuery(sqlQuery, sqlEntry->sqlValues);
+				StepQuery(sqlQuery, NULL);
+			}
+			
+			// keep track of earliest and latest EPG imported
+			startEPG = (startEPG < sqlEntry->startTime) ? startEPG : sqlEntry->startTime;
+			endEPG   = (endEPG   > sqlEntry->endTime  ) ? endEPG   : sqlEntry->endTime  ;
 		}
 		
-		// assign decompressed data back to content
-		content = decompressed;
-	}
-
-	// convert content to charr array
-	char* pLines = new char [content.length() + 1];
-	strcpy(pLines, content.c_str());
-
-	// create xml doc
-	xml_document<> xml;
-
-	// parse xml doc
-	try
-	{
-		xml.parse<0>(pLines);
-	}
-	catch (parse_error err)
-	{
-		// log issue
-		XBMC->Log(LOG_ERROR, "C+: %s - Failed to parse XMLTV file, %s", __FUNCTION__, err.what());
-
-		// return error
-		return;
+		// end transaction
+		if (!sqlWrite.empty())
+			EndTransaction();
+		
+		// release written rows
+		sqlWrite.clear();
 	}
+	
+	// stop decode workers
+	StopDecode(sqlQueue, tWorkers);
 
-	// get xml root
-	xml_node<> *pRootNode = xml.first_node(XMLTV_START_MARKER);
-
-	// check if valid EPG file
-	if (!pRootNode)
+	// drop partial copies if archive was cut short or corrupt (guide untouched, unread programmes would be dropped)
+	if (xmlReader.GetStatus() != Z_OK)
 	{
 		// log issue
-		XBMC->Log(LOG_ERROR, "C+: %s - Not a valid XMLTV file, skipping import", __FUNCTION__);
-
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to decompress XMLTV file (%i), skipping import", __FUNCTION__, xmlReader.GetStatus());
+		
+		// drop staging tables
+		DropStaging(strTables);
+		
+		// lock threads
+		SetLock();
+		
+		// drop programmes read
+		SendQuery("DROP TABLE IF EXISTS temp.EpgEntriesStaging", NULL);
+		
+		// unlock threads
+		SetUnlock();
+		
 		// return error
 		return;
 	}
 	
-	// create containers for parsed text for epg channels
-	string strTvgId   = "";
-	string strTvgName = "";
-	string strTvgLogo = "";	
+	// start transaction (guide merged as one, readers keep last commit until end)
+	BeginTransaction();
 	
-	// create container to look for channel
-	SQLRecord sqlEpgChannel;
+	// fetch compiled queries for changed programmes, guide ids losing programmes, merge, unlisted programmes, and guide journal entries
+	sqlite3_stmt *sqlChanged  = PrepareQuery(sqlEpgChanged                                                                                       );
+	sqlite3_stmt *sqlVanished = PrepareQuery(string("SELECT DISTINCT strTvgId FROM EpgEntries WHERE endTime >= ? AND") + sqlEpgUnseen                  );
+	sqlite3_stmt *sqlMerge    = PrepareQuery(sqlEpgMerge                                                                                         );
+	sqlite3_stmt *sqlDelete   = PrepareQuery(string("DELETE FROM EpgEntries WHERE"                                  ) + sqlEpgUnseen                  );
+	sqlite3_stmt *sqlJournal  = PrepareQuery(string("INSERT INTO Journal (strTable, strKey, iAction, iModTime) VALUES ('EpgEntries', ?, ?, ?)"));
 	
-	// start transaction
-	sqlite3_exec(sqlDatabase, "BEGIN TRANSACTION;", NULL, NULL, NULL);
-
-	// read in epg channels
-	for (xml_node<> *pChannelNode = pRootNode->first_node(XMLTV_CHANNEL_MARKER); pChannelNode; pChannelNode = pChannelNode->next_sibling(XMLTV_CHANNEL_MARKER))
-	{	
-		// get attributes from xml node (ignore display name, pure tvg id)
-		strTvgId   = GetXMLAttributeValue     (pChannelNode, XMLTV_CHANNEL_ID_MARKER ,                         "");
-		strTvgName =                                                                   EPG_CHANNEL_NO_NAME        ;
-		strTvgLogo = GetXMLChildAttributeValue(pChannelNode, XMLTV_ICON_MARKER       , XMLTV_SOURCE_MARKER,    ""); 
-		
-		// skip entries with no tvg-id
-		if (strTvgId == "")
-			continue;
-		
-		// add unique
-		if (!FindRecord("EpgChannels", "strTvgId", strTvgId.c_str(), sqlEpgChannel))
+	// create container for merge response
+	int iResponse = (sqlChanged && sqlVanished && sqlMerge && sqlDelete && sqlJournal) ? SQLITE_OK : SQLITE_ERROR;
+	
+	// mark guide ids of new or changed programmes (identical programmes not counted)
+	if (sqlChanged)
+	{
+		while (sqlite3_step(sqlChanged) == SQLITE_ROW)
 		{
-			// create sql ontainer
-			string sqlEpgChannel  = string("(strTvgId, strTvgName, strTvgLogo)") +
-								    string(" VALUES ") +  
-								    string("('") + StringUtils_Replace((strTvgId  ),"'", "''") + string("', ") +
-								    string(" '") + StringUtils_Replace((strTvgName),"'", "''") + string("', ") +
-								    string(" '") + StringUtils_Replace((strTvgLogo),"'", "''") + string("') ") ;
-										 		
-			// push to database
-			AddRecord("EpgChannels", sqlEpgChannel);
-
-			// log addition
-			XBMC->Log(LOG_DEBUG, "C+: %s - Added guide channel %s (%s)", __FUNCTION__, strTvgId.c_str(), strTvgName.c_str());
+			strChanged.insert((const char*)sqlite3_column_text(sqlChanged, 0));
+			iChanged++;
 		}
 		
-		// go through display names and add
-		for (xml_node<> *pDisplayNameNode = pChannelNode->first_node(XMLTV_CHANNEL_NAME_MARKER); pDisplayNameNode; pDisplayNameNode = pDisplayNameNode->next_sibling(XMLTV_CHANNEL_NAME_MARKER))
-		{
-			// get attributes from xml node (ignore display name, pure tvg id)
-			strTvgName = pDisplayNameNode->value();
-			
-			// add unique
-			if (!FindRecord("EpgChannels", "strTvgName", strTvgName.c_str(), sqlEpgChannel))
-			{
-				// create sql ontainer
-				string sqlEpgChannel  = string("(strTvgId, strTvgName, strTvgLogo)") +
-									    string(" VALUES ") +  
-									    string("('") + StringUtils_Replace((strTvgId  ),"'", "''") + string("', ") +
-									    string(" '") + StringUtils_Replace((strTvgName),"'", "''") + string("', ") +
-									    string(" '") + StringUtils_Replace((strTvgLogo),"'", "''") + string("') ") ;
-													
-				// push to database
-				AddRecord("EpgChannels", sqlEpgChannel);
-
-				// log addition
-				XBMC->Log(LOG_DEBUG, "C+: %s - Added guide channel %s (%s)", __FUNCTION__, strTvgId.c_str(), strTvgName.c_str());
-			}			
-		}
+		// release statement
+		sqlite3_reset(sqlChanged);
 	}
 	
-	// end transaction
-	sqlite3_exec(sqlDatabase, "END TRANSACTION;", NULL, NULL, NULL);
+	// mark guide ids losing programmes within horizon changed (older programmes are pruned by clients)
+	if (sqlVanished)
+	{
+		BindQuery(sqlVanished, {(long long)startHorizon});
+		
+		while (sqlite3_step(sqlVanished) == SQLITE_ROW)
+			strChanged.insert((const char*)sqlite3_column_text(sqlVanished, 0));
+		
+		// release statement
+		sqlite3_reset(sqlVanished);
+	}
 	
-	// create containers for parsed text for epg entries
-	int    iUniqueBroadcastId  = EPG_TAG_INVALID_UID           ;
-	int    iUniqueChannelId    = PVR_CHANNEL_INVALID_UID       ;
-	string strTitle            = ""                            ;
-	time_t startTime           = 0                             ;
-	time_t endTime             = 0                             ;
-	string strPlotOutline      = ""                            ;
-	string strPlot             = ""                            ;
-	string strOriginalTitle    = ""                            ;
-	string strCast             = ""                            ;
-	string strDirector         = ""                            ;
-	string strWriter           = ""                            ;
-	int    iYear               = 0                             ;
-	string strIMDBNumber       = ""                            ;
-	string strIconPath         = ""                            ;
-	int    iGenreType          = EPG_GENRE_USE_STRING          ;
-	int    iGenreSubType       = 0                             ;
-	string strGenreDescription = ""                            ;
-	time_t firstAired          = 0                             ;
-	int    iParentalRating     = 0                             ;
-	int    iStarRating         = 0                             ;
-	bool   bNotify             = false                         ;
-	int    iSeriesNumber       = EPG_TAG_INVALID_SERIES_EPISODE;
-	int    iEpisodeNumber      = EPG_TAG_INVALID_SERIES_EPISODE;
-	int    iEpisodePartNumber  = EPG_TAG_INVALID_SERIES_EPISODE;
-	string strEpisodeName      = ""                            ;
-	int    iFlags              = EPG_TAG_FLAG_UNDEFINED        ;
-	string strSeriesLink       = ""                            ;
-	  
-	// create container for epg days
-	time_t startEPG = time(NULL);
-	time_t endEPG   = time(NULL);
-
-	// create container to look for channel
-	SQLRecord sqlChannel;
+	// add new and rewrite changed programmes in place (ids kept)
+	if (iResponse == SQLITE_OK)
+		iResponse = StepQuery(sqlMerge, NULL);
 	
-	// start transaction
-	sqlite3_exec(sqlDatabase, "BEGIN TRANSACTION;", NULL, NULL, NULL);
-
-	// read in epg
-	for (xml_node<> *pProgrammeNode = pRootNode->first_node(XMLTV_PROGRAM_MARKER); pProgrammeNode; pProgrammeNode = pProgrammeNode->next_sibling(XMLTV_PROGRAM_MARKER))
-	{	
-		// get attributes from xml node
-		iUniqueBroadcastId  = ParseXMLDateTime  (GetXMLAttributeValue     (pProgrammeNode, XMLTV_STARTTM_MARKER    ,                                                                                       "0"));
-		iUniqueChannelId++                                                                                                                                                                                      ;
-		strTitle            =                    GetXMLNodeValue          (pProgrammeNode, XMLTV_TITLE_MARKER      , ""                                                    ,                                "") ;
-		startTime           = ParseXMLDateTime  (GetXMLAttributeValue     (pProgrammeNode, XMLTV_STARTTM_MARKER    ,                                                                                       "0"));
-		endTime             = ParseXMLDateTime  (GetXMLAttributeValue     (pProgrammeNode, XMLTV_STOPTM_MARKER     ,                                                                                       "0"));
-		strPlot             =                    GetXMLNodeValue          (pProgrammeNode, XMLTV_PLOT_MARKER       , ""                                                    ,                                "") ;
-		strCast             =                    GetXMLChildNodeValue     (pProgrammeNode, XMLTV_CREDITS_MARKER    , XMLTV_ACTOR_MARKER                                    , EPG_STRING_TOKEN_SEPARATOR,    "") ;
-		strDirector         =                    GetXMLChildNodeValue     (pProgrammeNode, XMLTV_CREDITS_MARKER    , XMLTV_DIRECTOR_MARKER                                 , EPG_STRING_TOKEN_SEPARATOR,    "") ;
-		strWriter           =                    GetXMLChildNodeValue     (pProgrammeNode, XMLTV_CREDITS_MARKER    , XMLTV_WRITER_MARKER                                   , EPG_STRING_TOKEN_SEPARATOR,    "") ;
-		iYear               = ParseXMLYear      (GetXMLNodeValue          (pProgrammeNode, XMLTV_DATE_MARKER       , ""                                                    ,                               "0"));
-		strIconPath         =                    GetXMLChildAttributeValue(pProgrammeNode, XMLTV_ICON_MARKER       , XMLTV_SOURCE_MARKER                                   ,                                "") ;
-		strGenreDescription =                    GetXMLNodeValue          (pProgrammeNode, XMLTV_GENRE_MARKER      , EPG_STRING_TOKEN_SEPARATOR                            ,                                "") ;
-		firstAired          = ParseXMLDate      (GetXMLNodeValue          (pProgrammeNode, XMLTV_DATE_MARKER       , ""                                                    ,                               "0"));
-		iStarRating         = ParseXMLStarRating(GetXMLChildNodeValue     (pProgrammeNode, XMLTV_STAR_RATING_MARKER, XMLTV_STAR_RATING_VALUE                               , EPG_STRING_TOKEN_SEPARATOR,    ""));
-		iSeriesNumber       = ParseXMLSeason    (GetXMLNodeValueAttr      (pProgrammeNode, XMLTV_SEASON_MARKER     , XMLTV_SEASON_ATTRIB_MARKER, XMLTV_SEASON_ATTRIB_VALUE , EPG_STRING_TOKEN_SEPARATOR,   "0"));
-		iEpisodeNumber      = ParseXMLEpisode   (GetXMLNodeValueAttr      (pProgrammeNode, XMLTV_SEASON_MARKER     , XMLTV_SEASON_ATTRIB_MARKER, XMLTV_SEASON_ATTRIB_VALUE , EPG_STRING_TOKEN_SEPARATOR,   "0"));
-		iEpisodePartNumber  = ParseXMLEpPart    (GetXMLNodeValueAttr      (pProgrammeNode, XMLTV_SEASON_MARKER     , XMLTV_SEASON_ATTRIB_MARKER, XMLTV_SEASON_ATTRIB_VALUE , EPG_STRING_TOKEN_SEPARATOR,   "0"));
-		strEpisodeName      =                    GetXMLNodeValue          (pProgrammeNode, XMLTV_EPISODE_MARKER    , ""                                                    ,                                "") ;
-		iFlags              =                                                              EPG_TAG_FLAG_UNDEFINED                                                                                               ;
-		strSeriesLink       = ParseXMLSeries    (GetXMLNodeValueAttr      (pProgrammeNode, XMLTV_SEASON_MARKER     , XMLTV_SEASON_ATTRIB_MARKER, XMLTV_SERIES_ATTRIB_VALUE , EPG_STRING_TOKEN_SEPARATOR,    ""));
-		strTvgId            =                    GetXMLAttributeValue     (pProgrammeNode, XMLTV_CHANNEL_MARKER    ,                                                                                        "") ;
-
-		// look for channel in database (skip if not found)
-		if (!FindRecord("EpgChannels", "strTvgId", strTvgId.c_str(), sqlChannel))
-			continue;
-		
-		// check if series add flag
-		if (strSeriesLink != "")
-			iFlags |= EPG_TAG_FLAG_IS_SERIES;
-		/*
-		// check if new and add flag
-		if (GetDate(startTime) = GetDate(firstAired))
-			iFlags |= EPG_TAG_FLAG_IS_NEW;
-		*/
-		// create sql ontainer
-		string sqlEpgEntry = string("(iUniqueBroadcastId, iUniqueChannelId   , strTitle        , startTime         , endTime       ,") + 
-							 string(" strPlotOutline    , strPlot            , strOriginalTitle, strCast           , strDirector   ,") +
-							 string(" strWriter         , iYear              , strIMDBNumber   , strIconPath       , iGenreType    ,") +
-							 string(" iGenreSubType     , strGenreDescription, firstAired      , iParentalRating   , iStarRating   ,") +
-							 string(" bNotify           , iSeriesNumber      , iEpisodeNumber  , iEpisodePartNumber, strEpisodeName,") +
-							 string(" iFlags            , strSeriesLink      , strTvgId                                            )") +
-							 string(" VALUES ") +  
-							 string("( ") + StringUtils_Replace(itos(iUniqueBroadcastId ),"'", "''") + string(" , ") +
-							 string("  ") + StringUtils_Replace(itos(iUniqueChannelId   ),"'", "''") + string(" , ") +
-							 string(" '") + StringUtils_Replace(    (strTitle           ),"'", "''") + string("', ") +
-							 string("  ") + StringUtils_Replace(itos(startTime          ),"'", "''") + string(" , ") +
-							 string("  ") + StringUtils_Replace(itos(endTime            ),"'", "''") + string(" , ") +
-							 string(" '") + StringUtils_Replace(    (strPlotOutline     ),"'", "''") + string("', ") +
-							 string(" '") + StringUtils_Replace(    (strPlot            ),"'", "''") + string("', ") +
-							 string(" '") + StringUtils_Replace(    (strOriginalTitle   ),"'", "''") + string("', ") +
-							 string(" '") + StringUtils_Replace(    (strCast            ),"'", "''") + string("', ") +
-							 string(" '") + StringUtils_Replace(    (strDirector        ),"'", "''") + string("', ") +
-							 string(" '") + StringUtils_Replace(    (strWriter          ),"'", "''") + string("', ") +
-							 string("  ") + StringUtils_Replace(itos(iYear              ),"'", "''") + string(" , ") +
-							 string(" '") + StringUtils_Replace(    (strIMDBNumber      ),"'", "''") + string("', ") +
-							 string(" '") + StringUtils_Replace(    (strIconPath        ),"'", "''") + string("', ") +
-							 string("  ") + StringUtils_Replace(itos(iGenreType         ),"'", "''") + string(" , ") +
-							 string("  ") + StringUtils_Replace(itos(iGenreSubType      ),"'", "''") + string(" , ") +
-							 string(" '") + StringUtils_Replace(    (strGenreDescription),"'", "''") + string("', ") +
-							 string("  ") + StringUtils_Replace(itos(firstAired         ),"'", "''") + string(" , ") +
-							 string("  ") + StringUtils_Replace(itos(iParentalRating    ),"'", "''") + string(" , ") +
-							 string("  ") + StringUtils_Replace(itos(iStarRating        ),"'", "''") + string(" , ") +
-							 string(" '") + StringUtils_Replace(btos(bNotify            ),"'", "''") + string("', ") +
-							 string("  ") + StringUtils_Replace(itos(iSeriesNumber      ),"'", "''") + string(" , ") +
-							 string("  ") + StringUtils_Replace(itos(iEpisodeNumber     ),"'", "''") + string(" , ") +
-							 string("  ") + StringUtils_Replace(itos(iEpisodePartNumber ),"'", "''") + string(" , ") +
-							 string(" '") + StringUtils_Replace(    (strEpisodeName     ),"'", "''") + string("', ") +
-							 string("  ") + StringUtils_Replace(itos(iFlags             ),"'", "''") + string(" , ") +
-							 string(" '") + StringUtils_Replace(    (strSeriesLink      ),"'", "''") + string("', ") +
-							 string(" '") + StringUtils_Replace(    (strTvgId           ),"'", "''") + string("') ") ;
-	
-		// push to database
-		AddRecord("EpgEntries", sqlEpgEntry);
-	
-		// log addition
-		XBMC->Log(LOG_DEBUG, "C+: %s - Added '%s' to guide (%s) from [%i - %i]", __FUNCTION__, strTitle.c_str(), strTvgId.c_str(), startTime, endTime);
-		
-		// keep track of earliest and latest EPG imported
-		startEPG = (startEPG < startTime) ? startEPG : startTime;
-		endEPG   = (endEPG   > endTime  ) ? endEPG   : endTime  ;
+	// drop programmes no longer listed
+	if (iResponse == SQLITE_OK)
+		if ((iResponse = StepQuery(sqlDelete, NULL)) == SQLITE_OK && sqlite3_changes(sqlDatabase))
+			XBMC->Log(LOG_NOTICE, "C+: %s - Removed %i guide entries no longer listed", __FUNCTION__, sqlite3_changes(sqlDatabase));
+	
+	// journal one change per guide id (clients refresh matching channels only)
+	for (unordered_set<string>::iterator strTvgId = strChanged.begin(); strTvgId != strChanged.end() && iResponse == SQLITE_OK; strTvgId++)
+	{
+		BindQuery(sqlJournal, {*strTvgId, (int)SQL_JOURNAL_UPDATE, (long long)time(NULL)});
+		iResponse = StepQuery(sqlJournal, NULL);
 	}
+	
+	// update change log if any guide changed
+	if (iResponse == SQLITE_OK && !strChanged.empty())
+		UpdateDBLog("EpgEntries");
+	
+	// release programmes read
+	SendQuery("DROP TABLE IF EXISTS temp.EpgEntriesStaging", NULL);
 
-	// end transaction
-	sqlite3_exec(sqlDatabase, "END TRANSACTION;", NULL, NULL, NULL);
+	// end transaction (guide kept as is if merge failed)
+	EndTransaction(iResponse == SQLITE_OK);
+	
+	// log failure and drop copies
+	if (iResponse != SQLITE_OK)
+	{
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to merge guide entries", __FUNCTION__);
+		DropStaging(strTables);
+		return;
+	}
+	
+	// swap in complete tables
+	if (!SwapStaging(strTables))
+		return;
 
 	// log epg entries imported
-	XBMC->Log(LOG_NOTICE, "C+: %s - %i guide entries imported", __FUNCTION__, GetTableSize("EpgEntries"));
+	XBMC->Log(LOG_NOTICE, "C+: %s - %i guide entries imported, %i changed on %i guide channel(s)", __FUNCTION__, GetTableSize("EpgEntries"), iChanged, (int)strChanged.size());
+	
+	// keep source of import
+	SaveSource(sqlSource);
 	  
 	// get read time of file
 	tLastEPGRead = time(NULL);
@@ -1660,9 +3512,6 @@ void SQLConnection::ImportTimerTypes(void)
 	
 	// create name container
 	string TIMER_NAME;
-	
-	// start transaction
-	sqlite3_exec(sqlDatabase, "BEGIN TRANSACTION;", NULL, NULL, NULL);
 	  
 	// add once manual type
 	             TIMER_NAME                = "One time";
@@ -1738,7 +3587,8 @@ void SQLConnection::ImportTimerTypes(void)
 	                                           PVR_TIMER_TYPE_SUPPORTS_END_TIME          | PVR_TIMER_TYPE_SUPPORTS_END_ANYTIME      |
 	                                           PVR_TIMER_TYPE_SUPPORTS_WEEKDAYS          | PVR_TIMER_TYPE_SUPPORTS_START_END_MARGIN |
 	                                           PVR_TIMER_TYPE_SUPPORTS_PRIORITY          | PVR_TIMER_TYPE_SUPPORTS_LIFETIME         |
-	                                           PVR_TIMER_TYPE_SUPPORTS_RECORDING_FOLDERS | PVR_TIMER_TYPE_SUPPORTS_ANY_CHANNEL      ;
+	                                           PVR_TIMER_TYPE_SUPPORTS_RECORDING_FOLDERS | PVR_TIMER_TYPE_SUPPORTS_ANY_CHANNEL      |
+	                                           PVR_TIMER_TYPE_SUPPORTS_RECORD_ONLY_NEW_EPISODES                                     ;
 	sqlResponse  = "";
 	sqlTimerType = string("(iId, iAttributes, strDescription, iPrioritiesSize, iLifetimesSize)") +
 	               string(" VALUES ") +  
@@ -1762,7 +3612,8 @@ void SQLConnection::ImportTimerTypes(void)
 	                                                  PVR_TIMER_TYPE_SUPPORTS_END_ANYTIME      | PVR_TIMER_TYPE_SUPPORTS_WEEKDAYS                |
 	                                                  PVR_TIMER_TYPE_SUPPORTS_START_END_MARGIN | PVR_TIMER_TYPE_SUPPORTS_PRIORITY                |
 	                                                  PVR_TIMER_TYPE_SUPPORTS_LIFETIME         | PVR_TIMER_TYPE_SUPPORTS_RECORDING_FOLDERS       |
-	                                                  PVR_TIMER_TYPE_SUPPORTS_ANY_CHANNEL      | PVR_TIMER_TYPE_REQUIRES_EPG_SERIESLINK_ON_CREATE;
+	                                                  PVR_TIMER_TYPE_SUPPORTS_ANY_CHANNEL      | PVR_TIMER_TYPE_REQUIRES_EPG_SERIESLINK_ON_CREATE|
+	                                                  PVR_TIMER_TYPE_SUPPORTS_RECORD_ONLY_NEW_EPISODES                                           ;
 	  
 	sqlResponse  = "";
 	sqlCommand   = string("Insert '")+TIMER_NAME+("' into Timer Types");
@@ -1780,9 +3631,6 @@ void SQLConnection::ImportTimerTypes(void)
 	// log addition
 	XBMC->Log(LOG_DEBUG, "C+: %s - Added timer type %s", __FUNCTION__, TIMER_NAME.c_str());
 	
-	// end transaction
-	sqlite3_exec(sqlDatabase, "END TRANSACTION;", NULL, NULL, NULL);
-	
 	// log timer types imported
 	XBMC->Log(LOG_NOTICE, "C+: %s - %i timer types imported", __FUNCTION__, GetTableSize("TimerTypes"));
 	  
@@ -1790,6 +3638,230 @@ void SQLConnection::ImportTimerTypes(void)
 	return;
 }
 
+/***********************************************************
+ * Guide Decode Definitions
+ ***********************************************************/
+void SQLConnection::StartDecode(SQLDecodeQueue& sqlQueue, vector<thread>& tWorkers)
+{
+	// nothing queued at start
+	sqlQueue.strElements = NULL ;
+	sqlQueue.sqlEntries  = NULL ;
+	sqlQueue.iNext       = 0    ;
+	sqlQueue.iPending    = 0    ;
+	sqlQueue.bStop       = false;
+	
+	// get number of workers
+	unsigned int iWorkers = thread::hardware_concurrency();
+	
+	iWorkers = (iWorkers < 1) ? 1 : (iWorkers > XMLTV_DECODE_THREADS) ? XMLTV_DECODE_THREADS : iWorkers;
+	
+	// start workers (sleep on queue until a batch is handed over)
+	for (unsigned int iWorker = 0; iWorker < iWorkers; iWorker++)
+		tWorkers.push_back(thread(DecodeWorker, &sqlQueue));
+}
+
+void SQLConnection::QueueDecode(SQLDecodeQueue& sqlQueue, const vector<string>* strElements, vector<SQLEpgRow>* sqlEntries)
+{
+	// create row for each element (workers fill their own rows, no locks needed)
+	sqlEntries->clear();
+	sqlEntries->resize(strElements->size());
+	
+	// hand batch to queue
+	sqlQueue.pMutex.lock();
+	sqlQueue.strElements = strElements        ;
+	sqlQueue.sqlEntries  = sqlEntries         ;
+	sqlQueue.iNext       = 0                  ;
+	sqlQueue.iPending    = strElements->size();
+	sqlQueue.pMutex.unlock();
+	
+	// wake workers
+	sqlQueue.cWork.notify_all();
+}
+
+void SQLConnection::WaitDecode(SQLDecodeQueue& sqlQueue)
+{
+	// lock queue
+	unique_lock<mutex> pLock(sqlQueue.pMutex);
+	
+	// sleep until every element of batch is decoded (returns at once if none queued)
+	while (sqlQueue.iPending)
+		sqlQueue.cDone.wait(pLock);
+	
+	// release batch
+	sqlQueue.strElements = NULL;
+	sqlQueue.sqlEntries  = NULL;
+}
+
+void SQLConnection::StopDecode(SQLDecodeQueue& sqlQueue, vector<thread>& tWorkers)
+{
+	// flag workers to leave
+	sqlQueue.pMutex.lock();
+	sqlQueue.bStop = true;
+	sqlQueue.pMutex.unlock();
+	
+	// wake workers
+	sqlQueue.cWork.notify_all();
+	
+	// wait for workers
+	for (vector<thread>::iterator tWorker = tWorkers.begin(); tWorker != tWorkers.end(); tWorker++)
+		tWorker->join();
+	
+	// clear workers
+	tWorkers.clear();
+}
+
+void SQLConnection::DecodeWorker(SQLDecodeQueue* sqlQueue)
+{
+	// lock queue
+	unique_lock<mutex> pLock(sqlQueue->pMutex);
+	
+	// take chunks until stopped
+	while (true)
+	{
+		// sleep until elements left to claim or stopping
+		while (!sqlQueue->bStop && (!sqlQueue->strElements || sqlQueue->iNext >= sqlQueue->strElements->size()))
+			sqlQueue->cWork.wait(pLock);
+		
+		// leave once stopped
+		if (sqlQueue->bStop)
+			return;
+		
+		// claim next chunk of batch
+		const vector<string> *strElements = sqlQueue->strElements;
+		vector<SQLEpgRow>    *sqlEntries  = sqlQueue->sqlEntries ;
+		size_t                iStart      = sqlQueue->iNext      ;
+		size_t                iEnd        = min(iStart + (size_t)XMLTV_DECODE_CHUNK, strElements->size());
+		
+		sqlQueue->iNext = iEnd;
+		
+		// decode chunk without holding queue
+		pLock.unlock();
+		DecodeEpgSlice(strElements, sqlEntries, iStart, iEnd);
+		pLock.lock();
+		
+		// wake import thread once batch is decoded
+		sqlQueue->iPending -= iEnd - iStart;
+		
+		if (!sqlQueue->iPending)
+			sqlQueue->cDone.notify_all();
+	}
+}
+
+void SQLConnection::DecodeEpgSlice(const vector<string>* strElements, vector<SQLEpgRow>* sqlEntries, const size_t iStart, const size_t iEnd)
+{
+	// create parse containers (one per chunk, reused per element)
+	vector<char>   strElement;
+	xml_document<> xmlElement;
+	
+	// create containers for parsed text for epg entries
+	int    iUniqueBroadcastId  = EPG_TAG_INVALID_UID           ;
+	int    iUniqueChannelId    = PVR_CHANNEL_INVALID_UID       ;
+	string strTitle            = ""                            ;
+	time_t startTime           = 0                             ;
+	time_t endTime             = 0                             ;
+	string strPlotOutline      = ""                            ;
+	string strPlot             = ""                            ;
+	string strOriginalTitle    = ""                            ;
+	string strCast             = ""                            ;
+	string strDirector         = ""                            ;
+	string strWriter           = ""                            ;
+	int    iYear               = 0                             ;
+	string strIMDBNumber       = ""                            ;
+	string strIconPath         = ""                            ;
+	int    iGenreType          = EPG_GENRE_USE_STRING          ;
+	int    iGenreSubType       = 0                             ;
+	string strGenreDescription = ""                            ;
+	time_t firstAired          = 0                             ;
+	int    iParentalRating     = 0                             ;
+	int    iStarRating         = 0                             ;
+	bool   bNotify             = false                         ;
+	int    iSeriesNumber       = EPG_TAG_INVALID_SERIES_EPISODE;
+	int    iEpisodeNumber      = EPG_TAG_INVALID_SERIES_EPISODE;
+	int    iEpisodePartNumber  = EPG_TAG_INVALID_SERIES_EPISODE;
+	string strEpisodeName      = ""                            ;
+	int    iFlags              = EPG_TAG_FLAG_UNDEFINED        ;
+	string strSeriesLink       = ""                            ;
+	string strTvgId            = ""                            ;
+	
+	// go through elements of chunk
+	for (size_t i = iStart; i < iEnd; i++)
+	{
+		// get row to fill
+		SQLEpgRow& sqlEntry = sqlEntries->at(i);
+		
+		// mark invalid until decoded
+		sqlEntry.bIsValid = false;
+		
+		// decode element (bad markup or values skip programme)
+		try
+		{
+			// copy element for in place parse
+			strElement.assign(strElements->at(i).begin(), strElements->at(i).end());
+			strElement.push_back('\0');
+			
+			// parse element alone
+			xmlElement.clear();
+			xmlElement.parse<0>(&strElement[0]);
+			
+			// get element node
+			const xml_node<> *pNode = xmlElement.first_node();
+			
+			// skip if empty
+			if (!pNode)
+				continue;
+			
+			// get attributes from xml node
+			startTime           = ParseXMLDateTime  (GetXMLAttributeValue     (pNode, XMLTV_STARTTM_MARKER    ,                                                                                       "0"));
+			endTime             = ParseXMLDateTime  (GetXMLAttributeValue     (pNode, XMLTV_STOPTM_MARKER     ,                                                                                       "0"));
+			iUniqueBroadcastId  =                                                              startTime                                                                                                            ;
+			strTitle            =                    GetXMLNodeValue          (pNode, XMLTV_TITLE_MARKER      , ""                                                    ,                                "") ;
+			strPlot             =                    GetXMLNodeValue          (pNode, XMLTV_PLOT_MARKER       , ""                                                    ,                                "") ;
+			strCast             =                    GetXMLChildNodeValue     (pNode, XMLTV_CREDITS_MARKER    , XMLTV_ACTOR_MARKER                                    , EPG_STRING_TOKEN_SEPARATOR,    "") ;
+			strDirector         =                    GetXMLChildNodeValue     (pNode, XMLTV_CREDITS_MARKER    , XMLTV_DIRECTOR_MARKER                                 , EPG_STRING_TOKEN_SEPARATOR,    "") ;
+			strWriter           =                    GetXMLChildNodeValue     (pNode, XMLTV_CREDITS_MARKER    , XMLTV_WRITER_MARKER                                   , EPG_STRING_TOKEN_SEPARATOR,    "") ;
+			iYear               = ParseXMLYear      (GetXMLNodeValue          (pNode, XMLTV_DATE_MARKER       , ""                                                    ,                               "0"));
+			strIconPath         =                    GetXMLChildAttributeValue(pNode, XMLTV_ICON_MARKER       , XMLTV_SOURCE_MARKER                                   ,                                "") ;
+			strGenreDescription =                    GetXMLNodeValue          (pNode, XMLTV_GENRE_MARKER      , EPG_STRING_TOKEN_SEPARATOR                            ,                                "") ;
+			firstAired          = ParseXMLDate      (GetXMLNodeValue          (pNode, XMLTV_DATE_MARKER       , ""                                                    ,                               "0"));
+			iStarRating         = ParseXMLStarRating(GetXMLChildNodeValue     (pNode, XMLTV_STAR_RATING_MARKER, XMLTV_STAR_RATING_VALUE                               , EPG_STRING_TOKEN_SEPARATOR,    ""));
+			iSeriesNumber       = ParseXMLSeason    (GetXMLNodeValueAttr      (pNode, XMLTV_SEASON_MARKER     , XMLTV_SEASON_ATTRIB_MARKER, XMLTV_SEASON_ATTRIB_VALUE , EPG_STRING_TOKEN_SEPARATOR,   "0"));
+			iEpisodeNumber      = ParseXMLEpisode   (GetXMLNodeValueAttr      (pNode, XMLTV_SEASON_MARKER     , XMLTV_SEASON_ATTRIB_MARKER, XMLTV_SEASON_ATTRIB_VALUE , EPG_STRING_TOKEN_SEPARATOR,   "0"));
+			iEpisodePartNumber  = ParseXMLEpPart    (GetXMLNodeValueAttr      (pNode, XMLTV_SEASON_MARKER     , XMLTV_SEASON_ATTRIB_MARKER, XMLTV_SEASON_ATTRIB_VALUE , EPG_STRING_TOKEN_SEPARATOR,   "0"));
+			strEpisodeName      =                    GetXMLNodeValue          (pNode, XMLTV_EPISODE_MARKER    , ""                                                    ,                                "") ;
+			iFlags              =                                                              EPG_TAG_FLAG_UNDEFINED                                                                                               ;
+			strSeriesLink       = ParseXMLSeries    (GetXMLNodeValueAttr      (pNode, XMLTV_SEASON_MARKER     , XMLTV_SEASON_ATTRIB_MARKER, XMLTV_SERIES_ATTRIB_VALUE , EPG_STRING_TOKEN_SEPARATOR,    ""));
+			strTvgId            =                    GetXMLAttributeValue     (pNode, XMLTV_CHANNEL_MARKER    ,                                                                                        "") ;
+			iUniqueChannelId    =                                                              stoh(strTvgId)                                                                                                       ;
+			
+			// check if series add flag
+			if (strSeriesLink != "")
+				iFlags |= EPG_TAG_FLAG_IS_SERIES;
+			/*
+			// check if new and add flag
+			if (GetDate(startTime) = GetDate(firstAired))
+				iFlags |= EPG_TAG_FLAG_IS_NEW;
+			*/
+			// fill row (bound in order of import columns, ids stable across imports)
+			sqlEntry.strTvgId  = strTvgId ;
+			sqlEntry.strTitle  = strTitle ;
+			sqlEntry.startTime = startTime;
+			sqlEntry.endTime   = endTime  ;
+			sqlEntry.sqlValues = {iUniqueBroadcastId , iUniqueChannelId   , strTitle        , startTime         , endTime       ,
+			                      strPlotOutline     , strPlot            , strOriginalTitle, strCast           , strDirector   ,
+			                      strWriter          , iYear              , strIMDBNumber   , strIconPath       , iGenreType    ,
+			                      iGenreSubType      , strGenreDescription, firstAired      , iParentalRating   , iStarRating   ,
+			                      bNotify            , iSeriesNumber      , iEpisodeNumber  , iEpisodePartNumber, strEpisodeName,
+			                      iFlags             , strSeriesLink      , strTvgId                                              };
+			sqlEntry.bIsValid  = true     ;
+		}
+		catch (exception& err)
+		{
+			// log issue and skip element
+			XBMC->Log(LOG_ERROR, "C+: %s - Failed to decode XMLTV programme, %s", __FUNCTION__, err.what());
+		}
+	}
+}
+
 /***********************************************************
  * Filter Definitions
  ***********************************************************/
@@ -1801,8 +3873,9 @@ void SQLConnection::FilterChannelsEPG(void)
 	// only execute if enabled in settings
 	if (settings->GetM3UFilter())
 	{
-		// get sql objects
-		vector<SQLRecord> sqlChannels = GetRecords("Channels");
+		// get channel objects
+		vector<IPTVChannel> cChannels;
+		GetRecords("Channels", cChannels);
 		
 		// create container to look for channel
 		SQLRecord sqlEpgChannel;
@@ -1811,23 +3884,15 @@ void SQLConnection::FilterChannelsEPG(void)
 		int iFilter = 0;
 		
 		// iterate through channels and hide those without epg data
-		for (vector<SQLRecord>::iterator sqlChannel = sqlChannels.begin(); sqlChannel != sqlChannels.end(); sqlChannel++)
+		for (vector<IPTVChannel>::iterator cChannel = cChannels.begin(); cChannel != cChannels.end(); cChannel++)
 		{			
-			// get id, and tvg data
-			int    iUniqueId  = stoi(ParseSQLValue(sqlChannel->GetRecord(), "<iUniqueId>" ,  0));
-			string strTvgId   =      ParseSQLValue(sqlChannel->GetRecord(), "<strTvgId>"  , "") ;
-			string strTvgName =      ParseSQLValue(sqlChannel->GetRecord(), "<strTvgName>", "") ;
-			
 			// check if exists in epg channels (hide if not)
-			if (!FindRecord("EpgChannels", "strTvgId", strTvgId.c_str(), sqlEpgChannel))
+			if (!FindRecord("EpgChannels", "strTvgId", cChannel->GetTvgId().c_str(), sqlEpgChannel))
 			{
-				if (!FindRecord("EpgChannels", "strTvgName", strTvgName.c_str(), sqlEpgChannel))
+				if (!FindRecord("EpgChannels", "strTvgName", cChannel->GetTvgName().c_str(), sqlEpgChannel))
 				{
 					// set to hidden
-					string strChannel = " SET bIsHidden = 'true' WHERE iUniqueId = " + itos(iUniqueId);
-					
-					// send to database
-					this->UpdateRecord("Channels", strChannel);	
+					this->UpdateRecord("Channels", " SET bIsHidden = ? WHERE iUniqueId = ?", {true, (int)cChannel->GetUniqueId()});
 
 					// increment counter for log
 					iFilter++;
@@ -1861,37 +3926,15 @@ PVR_ERROR SQLConnection::AddTimer(const PVR_TIMER &timer, int iSchedAdj /* = 0 *
 					  string(" iLifetime                , iMaxRecordings       , iRecordingGroup  , firstDay  , iWeekdays    ,") +
 					  string(" iPreventDuplicateEpisodes, iEpgUid, iMarginStart, iMarginEnd       , iGenreType, iGenreSubType,") +
 					  string(" strSeriesLink                                                                                 )") + 
-					  string(" VALUES ") + 
-					  string("( ") + StringUtils_Replace(itos(      iClientIndex             ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iParentClientIndex       ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iClientChannelUid        ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.startTime                ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.endTime                  ),"'", "''") + string(" , ") +
-					  string(" '") + StringUtils_Replace(btos(timer.bStartAnyTime            ),"'", "''") + string("', ") +
-					  string(" '") + StringUtils_Replace(btos(timer.bEndAnyTime              ),"'", "''") + string("', ") +
-					  string("  ") + StringUtils_Replace(itos(timer.state                    ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iTimerType               ),"'", "''") + string(" , ") +
-					  string(" '") + StringUtils_Replace(    (timer.strTitle                 ),"'", "''") + string("', ") +
-					  string(" '") + StringUtils_Replace(    (timer.strEpgSearchString       ),"'", "''") + string("', ") +
-					  string(" '") + StringUtils_Replace(btos(timer.bFullTextEpgSearch       ),"'", "''") + string("', ") +
-					  string(" '") + StringUtils_Replace(    (timer.strDirectory             ),"'", "''") + string("', ") +
-					  string(" '") + StringUtils_Replace(    (timer.strSummary               ),"'", "''") + string("', ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iPriority                ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iLifetime                ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iMaxRecordings           ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iRecordingGroup          ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.firstDay                 ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iWeekdays                ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iPreventDuplicateEpisodes),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iEpgUid                  ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iMarginStart             ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iMarginEnd               ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iGenreType               ),"'", "''") + string(" , ") +
-					  string("  ") + StringUtils_Replace(itos(timer.iGenreSubType            ),"'", "''") + string(" , ") +
-					  string(" '") + StringUtils_Replace(    (timer.strSeriesLink            ),"'", "''") + string("');") ;
+					  string(" VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"     ) ;
 					  				  
 	// send to database
-	this->AddRecord("Timers", strTimer);
+	this->AddRecord("Timers", strTimer, {      iClientIndex             , timer.iParentClientIndex, timer.iClientChannelUid , timer.startTime    , timer.endTime       ,
+	                                     timer.bStartAnyTime            , timer.bEndAnyTime       , (int)timer.state        , timer.iTimerType   , timer.strTitle      ,
+	                                     timer.strEpgSearchString       , timer.bFullTextEpgSearch, timer.strDirectory      , timer.strSummary   , timer.iPriority     ,
+	                                     timer.iLifetime                , timer.iMaxRecordings    , timer.iRecordingGroup   , timer.firstDay     , timer.iWeekdays     ,
+	                                     timer.iPreventDuplicateEpisodes, timer.iEpgUid           , timer.iMarginStart      , timer.iMarginEnd   , timer.iGenreType    ,
+	                                     timer.iGenreSubType            , timer.strSeriesLink                                                                          });
 	
 	// log addition of entry
 	XBMC->Log(LOG_NOTICE, "C+: %s - Created %s timer (%i)", __FUNCTION__, timer.strTitle, iClientIndex);
@@ -1906,10 +3949,7 @@ PVR_ERROR SQLConnection::DeleteTimer(const PVR_TIMER &timer, bool bForceDelete)
 	CPPLog();
 	
 	// this is only called on missed or error recordings (so set to cancelled, let stop timer handle active recordings)
-	string strTimer = " SET state = " + itos(PVR_TIMER_STATE_CANCELLED) + " WHERE iClientIndex = " + itos(timer.iClientIndex) + " OR iParentClientIndex = " + itos(timer.iParentClientIndex) + ";";
-	
-	// send to database
-	this->UpdateRecord("Timers", strTimer);
+	this->UpdateRecord("Timers", " SET state = ? WHERE iClientIndex = ? OR iParentClientIndex = ?", {(int)PVR_TIMER_STATE_CANCELLED, timer.iClientIndex, timer.iParentClientIndex});
 
 	// log deletion of entry
 	XBMC->Log(LOG_NOTICE, "C+: %s - Deleted %s timer (%i)", __FUNCTION__, timer.strTitle, timer.iClientIndex);
@@ -1927,10 +3967,7 @@ PVR_ERROR SQLConnection::StartTimer(const PVR_TIMER &timer)
 	XBMC->Log(LOG_NOTICE, "C+: %s - Attempting to start %s recording (%i)", __FUNCTION__, timer.strTitle, timer.iClientIndex);
 			
 	// flag as recording
-	string strTimer = " SET state = " + itos(PVR_TIMER_STATE_RECORDING) + " WHERE iClientIndex = " + itos(timer.iClientIndex) + ";";
-	
-	// update in database
-	this->UpdateRecord("Timers", strTimer);
+	this->UpdateRecord("Timers", " SET state = ? WHERE iClientIndex = ?", {(int)PVR_TIMER_STATE_RECORDING, timer.iClientIndex});
 
 	// create process
 	SQLTask sqlTask;
@@ -1938,6 +3975,7 @@ PVR_ERROR SQLConnection::StartTimer(const PVR_TIMER &timer)
 	sqlTask.iClientIndex      = timer.iClientIndex;
 	sqlTask.iClientChannelUid = timer.iClientChannelUid;
 	sqlTask.iEpgUid           = timer.iEpgUid;
+	sqlTask.strSource         = GetSource(timer.iClientChannelUid);
 	sqlTask.pProcess          = new PVRRecorder(timer.iClientIndex, timer.iClientChannelUid, timer.iEpgUid);
 	
 	// add to vector
@@ -1947,7 +3985,7 @@ PVR_ERROR SQLConnection::StartTimer(const PVR_TIMER &timer)
 	return PVR_ERROR_NO_ERROR;
 }
 
-PVR_ERROR SQLConnection::StopTimer(const PVR_TIMER &timer)
+PVR_ERROR SQLConnection::StopTimer(const PVR_TIMER &timer, PVR_TIMER_STATE iState)
 {
 	// log function call
 	CPPLog();
@@ -1955,11 +3993,8 @@ PVR_ERROR SQLConnection::StopTimer(const PVR_TIMER &timer)
 	// log attempt to stop
 	XBMC->Log(LOG_NOTICE, "C+: %s - Attempting to stop %s recording (%i)", __FUNCTION__, timer.strTitle, timer.iClientIndex);
 	
-	// flag as recording
-	string strTimer = " SET state = " + itos(PVR_TIMER_STATE_COMPLETED) + " WHERE iClientIndex = " + itos(timer.iClientIndex) + ";";
-	
-	// update in database
-	this->UpdateRecord("Timers", strTimer);
+	// flag as completed (or aborted if preempted)
+	this->UpdateRecord("Timers", " SET state = ? WHERE iClientIndex = ?", {(int)iState, timer.iClientIndex});
 	
 	// iterate through processes and stop the recording
 	for (vector<SQLTask>::iterator sqlTask = sqlTasks.begin(); sqlTask != sqlTasks.end(); sqlTask++)
@@ -1989,7 +4024,7 @@ PVR_ERROR SQLConnection::StopTimer(const PVR_TIMER &timer)
 	return PVR_ERROR_NO_ERROR;
 }
 
-PVR_ERROR SQLConnection::ScheduleTimer(const PVR_TIMER &timer)
+PVR_ERROR SQLConnection::ScheduleTimer(const PVR_TIMER &timer, vector<DVRTimer>& cTimers)
 {
 	// log function call
 	CPPLog(); 
@@ -2001,17 +4036,29 @@ PVR_ERROR SQLConnection::ScheduleTimer(const PVR_TIMER &timer)
 		return PVR_ERROR_NO_ERROR;
 	}
 	
-	// fetch current containers
-	vector<SQLRecord> sqlChannels    = this->GetRecords("Channels"   );
-	vector<SQLRecord> sqlEpgChannels = this->GetRecords("EpgChannels");
-	vector<SQLRecord> sqlEpgEntries  = this->GetRecords("EpgEntries" );
-	vector<SQLRecord> sqlTimers      = this->GetRecords("Timers"     );
-  
 	// create schedule container
 	vector<DVRTimer> cSchedules;
 
 	// initialize schecule container
 	cSchedules.clear();
+	
+	// create keys of timers already scheduled (channel, start, end)
+	unordered_set<string> strScheduled;
+	
+	for (vector<DVRTimer>::iterator cTimer = cTimers.begin(); cTimer != cTimers.end(); cTimer++)
+		if (cTimer->GetState() == PVR_TIMER_STATE_SCHEDULED || cTimer->GetState() == PVR_TIMER_STATE_RECORDING || cTimer->GetState() == PVR_TIMER_STATE_COMPLETED || cTimer->GetState() == PVR_TIMER_STATE_ABORTED || cTimer->GetState() == PVR_TIMER_STATE_CONFLICT_NOK)
+			if (cTimer->GetTimerType() == TIMER_ONCE_MANUAL || cTimer->GetTimerType() == TIMER_ONCE_EPG)
+				strScheduled.insert(GetTimerKey(cTimer->GetClientChannelUid(), cTimer->GetStartTime(), cTimer->GetEndTime()));
+	
+	// create keys of episodes already recorded (only new episodes are scheduled if set)
+	unordered_set<string> strEpisodes;
+	
+	if (timer.iPreventDuplicateEpisodes && timer.iTimerType != TIMER_REPEATING_MANUAL)
+		this->GetEpisodes(timer.strTitle, strEpisodes);
+	
+	// create containers for candidate keys
+	string strTimerKey  ;
+	string strEpisodeKey;
 	   
 	// get number of days stored in guide
 	int iEPGDays = this->GetEPGDays();
@@ -2027,165 +4074,118 @@ PVR_ERROR SQLConnection::ScheduleTimer(const PVR_TIMER &timer)
 	// get list of possible EPG entries for guide based timers
 	if (timer.iTimerType != TIMER_REPEATING_MANUAL)
 	{
-		// iterate through EPG entries
-		for (vector<SQLRecord>::iterator sqlChannel = sqlChannels.begin(); sqlChannel != sqlChannels.end(); sqlChannel++)
+		// create channel and epg channel containers
+		SQLRecord sqlChannel   ;
+		SQLRecord sqlEpgChannel;
+		
+		// look for channel of rule (keyed lookup, no table scan)
+		if (this->FindRecord("Channels", "iUniqueId", timer.iClientChannelUid, sqlChannel))
 		{
-			// convert to c type
-			IPTVChannel cChannel(sqlChannel->GetRecord());
+			// get the tvg data from the channel
+			string strTvgId   = ParseSQLValue(sqlChannel.GetRecord(), "<strTvgId>"  , "");
+			string strTvgName = ParseSQLValue(sqlChannel.GetRecord(), "<strTvgName>", "");
 			
-			// look for tv guide id
-			if (cChannel.GetUniqueId() == timer.iClientChannelUid)
+			// look for an EPG channel by tvg id or display name (same match as recorder)
+			if (this->FindRecord("EpgChannels", "strTvgId", strTvgId.c_str(), sqlEpgChannel) || this->FindRecord("EpgChannels", "strTvgName", strTvgName.c_str(), sqlEpgChannel))
 			{
-				// iterate through epg channels to get tvg id or display name
-				for (vector<SQLRecord>::iterator sqlEpgChannel = sqlEpgChannels.begin(); sqlEpgChannel != sqlEpgChannels.end(); sqlEpgChannel++)
+				// get the tvg id from epg channel
+				strTvgId = ParseSQLValue(sqlEpgChannel.GetRecord(), "<strTvgId>", "");
+				
+				// get rule times of day (compared as seconds, no formatting per entry)
+				int iStartSeconds = ParseSeconds(timer.startTime);
+				int iEndSeconds   = ParseSeconds(timer.endTime  );
+				
+				// open cursor on entries of channel with same series link or title not missed (tvg id and column index)
+				SQLCursor sqlCursor;
+				
+				if (timer.iTimerType == TIMER_REPEATING_SERIESLINK)
+					this->GetEpgEntries(strTvgId.c_str(), "strSeriesLink", timer.strSeriesLink, time(NULL), sqlCursor);
+				else
+					this->GetEpgEntries(strTvgId.c_str(), "strTitle"     , timer.strTitle     , time(NULL), sqlCursor);
+				
+				// stream EPG and pass back entries
+				while (sqlCursor.Next())
 				{
-					// convert to c type
-					IPTVEpgChannel cEpgChannel(sqlEpgChannel->GetRecord());
-			
-					// look for tv guide id or display name 
-					if (StringUtils::EqualsNoCase(StringUtils_Trim(cEpgChannel.GetTvgId()), StringUtils_Trim(cChannel.GetTvgId())) || StringUtils::EqualsNoCase(StringUtils_Trim(cEpgChannel.GetTvgName()), StringUtils_Trim(cChannel.GetTvgName())))
+					// initialize record
+					IPTVEpgEntry cEpgEntry(sqlCursor.GetRow());
+					
+					// look for same day, time
+					if ((ParseWeekDay(cEpgEntry.GetStartTime())  &  (timer.iWeekdays)                        ) &&
+					    (ParseSeconds(cEpgEntry.GetStartTime()) == (iStartSeconds   ) || (timer.bStartAnyTime)) &&
+					    (ParseSeconds(cEpgEntry.GetEndTime()  ) == (iEndSeconds     ) || (timer.bEndAnyTime  ))   )
 					{
-						// iterate through EPG and pass back entries
-						for (vector<SQLRecord>::iterator sqlEpgEntry = sqlEpgEntries.begin(); sqlEpgEntry != sqlEpgEntries.end(); sqlEpgEntry++)
+						// create keys of airing and episode
+						strTimerKey   = GetTimerKey  (timer.iClientChannelUid, cEpgEntry.GetStartTime()  , cEpgEntry.GetEndTime()                              );
+						strEpisodeKey = GetEpisodeKey(timer.strTitle         , cEpgEntry.GetSeriesNumber(), cEpgEntry.GetEpisodeNumber(), cEpgEntry.GetEpisodeName());
+						
+						// skip if already scheduled (episode counts as taken by earliest airing)
+						if (!strScheduled.insert(strTimerKey).second)
 						{
-							// convert to c type
-							IPTVEpgEntry cEpgEntry(sqlEpgEntry->GetRecord());
-					
-							// only add entries not missed
-							if (time(NULL) <= cEpgEntry.GetEndTime())
-							{
-								// look for same broadcast channel, title, day, time
-								switch (timer.iTimerType)
-								{
-									case TIMER_REPEATING_EPG:
-										if ((            (cEpgEntry.GetTvgId()    ) ==          (cEpgChannel.GetTvgId())                         ) &&
-										    (string      (cEpgEntry.GetTitle()    ) == string   (timer.strTitle        )                         ) &&
-										    (ParseWeekDay(cEpgEntry.GetStartTime())  &          (timer.iWeekdays       )                         ) &&
-										    (ParseTime   (cEpgEntry.GetStartTime()) == ParseTime(timer.startTime       ) || (timer.bStartAnyTime)) &&
-										    (ParseTime   (cEpgEntry.GetEndTime()  ) == ParseTime(timer.endTime         ) || (timer.bEndAnyTime  ))   )
-										{
-											// clear out summary text
-											strSummary = "";
-
-											// create new summary text
-											dtm = cEpgEntry.GetStartTime();
-											ptm = localtime(&dtm);
-											strftime(chr, 64, "%m/%d/%Y from %I:%M %p", ptm);
-											strSummary += chr;
-											StringUtils::Replace(strSummary, "from 0", "from ");
-
-											dtm = cEpgEntry.GetEndTime();
-											ptm = localtime(&dtm);
-											strftime(chr, 64, " to %I:%M %p", ptm);
-											strSummary += chr;
-											StringUtils::Replace(strSummary, "to 0", "to ");
-
-											// assign values to entry						
-											string sqlTimer = "<iClientIndex>"              + itos(PVR_TIMER_NO_CLIENT_INDEX       ) + "</iClientIndex>"              +
-															  "<iParentClientIndex>"        + itos(timer.iClientIndex              ) + "</iParentClientIndex>"        +
-															  "<iClientChannelUid>"         + itos(timer.iClientChannelUid         ) + "</iClientChannelUid>"         +
-															  "<startTime>"                 + itos(cEpgEntry.GetStartTime()        ) + "</startTime>"                 +
-															  "<endTime>"                   + itos(cEpgEntry.GetEndTime()          ) + "</endTime>"                   +
-															  "<bStartAnyTime>"             + btos(false                           ) + "</bStartAnyTime>"             +
-															  "<bEndAnyTime>"               + btos(false                           ) + "</bEndAnyTime>"               +
-															  "<state>"                     + itos(timer.state                     ) + "</state>"                     +
-															  "<iTimerType>"                + itos(TIMER_ONCE_EPG                  ) + "</iTimerType>"                +
-															  "<strTitle>"                  +      timer.strTitle                    + "</strTitle>"                  +
-															  "<strEpgSearchString>"        +      timer.strEpgSearchString          + "</strEpgSearchString>"        +
-															  "<bFullTextEpgSearch>"        + btos(timer.bFullTextEpgSearch        ) + "</bFullTextEpgSearch>"        +
-															  "<strDirectory>"              +      timer.strDirectory                + "</strDirectory>"              +
-															  "<strSummary>"                +            strSummary.c_str()          + "</strSummary>"                +
-															  "<iPriority>"                 + itos(timer.iPriority                 ) + "</iPriority>"                 +
-															  "<iLifetime>"                 + itos(timer.iLifetime                 ) + "</iLifetime>"                 +
-															  "<iMaxRecordings>"            + itos(timer.iMaxRecordings            ) + "</iMaxRecordings>"            +
-															  "<iRecordingGroup>"           + itos(timer.iRecordingGroup           ) + "</iRecordingGroup>"           +
-															  "<firstDay>"                  + itos(timer.firstDay                  ) + "</firstDay>"                  +
-															  "<iWeekdays>"                 + itos(PVR_WEEKDAY_NONE                ) + "</iWeekdays>"                 +
-															  "<iPreventDuplicateEpisodes>" + itos(timer.iPreventDuplicateEpisodes ) + "</iPreventDuplicateEpisodes>" +
-															  "<iEpgUid>"                   + itos(cEpgEntry.GetUniqueBroadcastId()) + "</iEpgUid>"                   +
-															  "<iMarginStart>"              + itos(timer.iMarginStart              ) + "</iMarginStart>"              +
-															  "<iMarginEnd>"                + itos(timer.iMarginEnd                ) + "</iMarginEnd>"                +
-															  "<iGenreType>"                + itos(timer.iGenreType                ) + "</iGenreType>"                +
-															  "<iGenreSubType>"             + itos(timer.iGenreSubType             ) + "</iGenreSubType>"             +
-															  "<strSeriesLink>"             +      timer.strSeriesLink               + "</strSeriesLink>"             ;
-															  
-											// create container
-											DVRTimer cTimer(sqlTimer);
-
-											// add to schedule
-											cSchedules.push_back(cTimer);
-										}
-										break;
-									case TIMER_REPEATING_SERIESLINK:
-										if ((            (cEpgEntry.GetTvgId()     ) ==          (cEpgChannel.GetTvgId())                         ) &&
-										    (string      (cEpgEntry.GetSeriesLink()) == string   (timer.strSeriesLink   )                         ) &&
-										    (ParseWeekDay(cEpgEntry.GetStartTime() )  &          (timer.iWeekdays       )                         ) &&
-										    (ParseTime   (cEpgEntry.GetStartTime() ) == ParseTime(timer.startTime       ) || (timer.bStartAnyTime)) &&
-										    (ParseTime   (cEpgEntry.GetEndTime()   ) == ParseTime(timer.endTime         ) || (timer.bEndAnyTime  ))   )
-										{
-											// clear out summary text
-											strSummary = "";
-
-											// create new summary text
-											dtm = cEpgEntry.GetStartTime();
-											ptm = localtime(&dtm);
-											strftime(chr, 64, "%m/%d/%Y from %I:%M %p", ptm);
-											strSummary += chr;
-											StringUtils::Replace(strSummary, "from 0", "to ");
-
-											dtm = cEpgEntry.GetEndTime();
-											ptm = localtime(&dtm);
-											strftime(chr, 64, " to %I:%M %p", ptm);
-											strSummary += chr;
-											StringUtils::Replace(strSummary, "to 0", "to ");
-
-											// assign values to entry						
-											string sqlTimer = "<iClientIndex>"              + itos(PVR_TIMER_NO_CLIENT_INDEX       ) + "</iClientIndex>"              +
-															  "<iParentClientIndex>"        + itos(timer.iClientIndex              ) + "</iParentClientIndex>"        +
-															  "<iClientChannelUid>"         + itos(timer.iClientChannelUid         ) + "</iClientChannelUid>"         +
-															  "<startTime>"                 + itos(cEpgEntry.GetStartTime()        ) + "</startTime>"                 +
-															  "<endTime>"                   + itos(cEpgEntry.GetEndTime()          ) + "</endTime>"                   +
-															  "<bStartAnyTime>"             + btos(false                           ) + "</bStartAnyTime>"             +
-															  "<bEndAnyTime>"               + btos(false                           ) + "</bEndAnyTime>"               +
-															  "<state>"                     + itos(timer.state                     ) + "</state>"                     +
-															  "<iTimerType>"                + itos(TIMER_ONCE_EPG                  ) + "</iTimerType>"                +
-															  "<strTitle>"                  +      timer.strTitle                    + "</strTitle>"                  +
-															  "<strEpgSearchString>"        +      timer.strEpgSearchString          + "</strEpgSearchString>"        +
-															  "<bFullTextEpgSearch>"        + btos(timer.bFullTextEpgSearch        ) + "</bFullTextEpgSearch>"        +
-															  "<strDirectory>"              +      timer.strDirectory                + "</strDirectory>"              +
-															  "<strSummary>"                +            strSummary.c_str()          + "</strSummary>"                +
-															  "<iPriority>"                 + itos(timer.iPriority                 ) + "</iPriority>"                 +
-															  "<iLifetime>"                 + itos(timer.iLifetime                 ) + "</iLifetime>"                 +
-															  "<iMaxRecordings>"            + itos(timer.iMaxRecordings            ) + "</iMaxRecordings>"            +
-															  "<iRecordingGroup>"           + itos(timer.iRecordingGroup           ) + "</iRecordingGroup>"           +
-															  "<firstDay>"                  + itos(timer.firstDay                  ) + "</firstDay>"                  +
-															  "<iWeekdays>"                 + itos(PVR_WEEKDAY_NONE                ) + "</iWeekdays>"                 +
-															  "<iPreventDuplicateEpisodes>" + itos(timer.iPreventDuplicateEpisodes ) + "</iPreventDuplicateEpisodes>" +
-															  "<iEpgUid>"                   + itos(cEpgEntry.GetUniqueBroadcastId()) + "</iEpgUid>"                   +
-															  "<iMarginStart>"              + itos(timer.iMarginStart              ) + "</iMarginStart>"              +
-															  "<iMarginEnd>"                + itos(timer.iMarginEnd                ) + "</iMarginEnd>"                +
-															  "<iGenreType>"                + itos(timer.iGenreType                ) + "</iGenreType>"                +
-															  "<iGenreSubType>"             + itos(timer.iGenreSubType             ) + "</iGenreSubType>"             +
-															  "<strSeriesLink>"             +      timer.strSeriesLink               + "</strSeriesLink>"             ;
-															  
-											// create container
-											DVRTimer cTimer(sqlTimer);
-
-											// add to schedule
-											cSchedules.push_back(cTimer);
-										}
-										break;
-								}
-							}
+							if (strEpisodeKey != "")
+								strEpisodes.insert(strEpisodeKey);
+							
+							continue;
+						}
+						
+						// skip if episode recorded or scheduled earlier (entries come in start order)
+						if (timer.iPreventDuplicateEpisodes && strEpisodeKey != "" && !strEpisodes.insert(strEpisodeKey).second)
+						{
+							XBMC->Log(LOG_DEBUG, "C+: %s - Skipped repeat of %s episode (%s)", __FUNCTION__, timer.strTitle, strEpisodeKey.c_str());
+							continue;
 						}
 						
-						// exit loop
-						break;
+						// clear out summary text
+						strSummary = "";
+
+						// create new summary text
+						dtm = cEpgEntry.GetStartTime();
+						ptm = localtime(&dtm);
+						strftime(chr, 64, "%m/%d/%Y from %I:%M %p", ptm);
+						strSummary += chr;
+						StringUtils::Replace(strSummary, "from 0", "from ");
+
+						dtm = cEpgEntry.GetEndTime();
+						ptm = localtime(&dtm);
+						strftime(chr, 64, " to %I:%M %p", ptm);
+						strSummary += chr;
+						StringUtils::Replace(strSummary, "to 0", "to ");
+
+						// assign values to entry						
+						string sqlTimer = "<iClientIndex>"              + itos(PVR_TIMER_NO_CLIENT_INDEX          ) + "</iClientIndex>"              +
+										  "<iParentClientIndex>"        + itos(timer.iClientIndex                 ) + "</iParentClientIndex>"        +
+										  "<iClientChannelUid>"         + itos(timer.iClientChannelUid            ) + "</iClientChannelUid>"         +
+										  "<startTime>"                 + itos(cEpgEntry.GetStartTime()           ) + "</startTime>"                 +
+										  "<endTime>"                   + itos(cEpgEntry.GetEndTime()             ) + "</endTime>"                   +
+										  "<bStartAnyTime>"             + btos(false                              ) + "</bStartAnyTime>"             +
+										  "<bEndAnyTime>"               + btos(false                              ) + "</bEndAnyTime>"               +
+										  "<state>"                     + itos(timer.state                        ) + "</state>"                     +
+										  "<iTimerType>"                + itos(TIMER_ONCE_EPG                     ) + "</iTimerType>"                +
+										  "<strTitle>"                  + EscapeSQLValue(timer.strTitle           ) + "</strTitle>"                  +
+										  "<strEpgSearchString>"        + EscapeSQLValue(timer.strEpgSearchString ) + "</strEpgSearchString>"        +
+										  "<bFullTextEpgSearch>"        + btos(timer.bFullTextEpgSearch           ) + "</bFullTextEpgSearch>"        +
+										  "<strDirectory>"              + EscapeSQLValue(timer.strDirectory       ) + "</strDirectory>"              +
+										  "<strSummary>"                + EscapeSQLValue(strSummary               ) + "</strSummary>"                +
+										  "<iPriority>"                 + itos(timer.iPriority                    ) + "</iPriority>"                 +
+										  "<iLifetime>"                 + itos(timer.iLifetime                    ) + "</iLifetime>"                 +
+										  "<iMaxRecordings>"            + itos(timer.iMaxRecordings               ) + "</iMaxRecordings>"            +
+										  "<iRecordingGroup>"           + itos(timer.iRecordingGroup              ) + "</iRecordingGroup>"           +
+										  "<firstDay>"                  + itos(timer.firstDay                     ) + "</firstDay>"                  +
+										  "<iWeekdays>"                 + itos(PVR_WEEKDAY_NONE                   ) + "</iWeekdays>"                 +
+										  "<iPreventDuplicateEpisodes>" + itos(timer.iPreventDuplicateEpisodes    ) + "</iPreventDuplicateEpisodes>" +
+										  "<iEpgUid>"                   + itos(cEpgEntry.GetUniqueBroadcastId()   ) + "</iEpgUid>"                   +
+										  "<iMarginStart>"              + itos(timer.iMarginStart                 ) + "</iMarginStart>"              +
+										  "<iMarginEnd>"                + itos(timer.iMarginEnd                   ) + "</iMarginEnd>"                +
+										  "<iGenreType>"                + itos(timer.iGenreType                   ) + "</iGenreType>"                +
+										  "<iGenreSubType>"             + itos(timer.iGenreSubType                ) + "</iGenreSubType>"             +
+										  "<strSeriesLink>"             + EscapeSQLValue(timer.strSeriesLink      ) + "</strSeriesLink>"             ;
+										  
+						// create container
+						DVRTimer cTimer(sqlTimer);
+
+						// add to schedule
+						cSchedules.push_back(cTimer);
 					}
 				}
-				
-				// exit loop
-				break;
 			}
 		}
 	}
@@ -2262,8 +4262,8 @@ PVR_ERROR SQLConnection::ScheduleTimer(const PVR_TIMER &timer)
 			// create end datetime for new entry
 			endTime = mktime(ptm);
 
-			// look for same day
-			if (ParseWeekDay(startTime) & (timer.iWeekdays))
+			// look for same day not already scheduled
+			if ((ParseWeekDay(startTime) & (timer.iWeekdays)) && strScheduled.insert(GetTimerKey(timer.iClientChannelUid, startTime, endTime)).second)
 			{
 				// clear out summary text
 				strSummary = "";
@@ -2282,33 +4282,33 @@ PVR_ERROR SQLConnection::ScheduleTimer(const PVR_TIMER &timer)
 				StringUtils::Replace(strSummary, "to 0", "to ");
 
 				// assign values to entry						
-				string sqlTimer = "<iClientIndex>"              + itos(PVR_TIMER_NO_CLIENT_INDEX        ) + "</iClientIndex>"              +
-								  "<iParentClientIndex>"        + itos(timer.iClientIndex               ) + "</iParentClientIndex>"        +
-								  "<iClientChannelUid>"         + itos(timer.iClientChannelUid          ) + "</iClientChannelUid>"         +
-								  "<startTime>"                 + itos(      startTime                  ) + "</startTime>"                 +
-								  "<endTime>"                   + itos(      endTime                    ) + "</endTime>"                   +
-								  "<bStartAnyTime>"             + btos(false                            ) + "</bStartAnyTime>"             +
-								  "<bEndAnyTime>"               + btos(false                            ) + "</bEndAnyTime>"               +
-								  "<state>"                     + itos(timer.state                      ) + "</state>"                     +
-								  "<iTimerType>"                + itos(TIMER_ONCE_MANUAL                ) + "</iTimerType>"                +
-								  "<strTitle>"                  +      timer.strTitle                     + "</strTitle>"                  +
-								  "<strEpgSearchString>"        +      timer.strEpgSearchString           + "</strEpgSearchString>"        +
-								  "<bFullTextEpgSearch>"        + btos(timer.bFullTextEpgSearch         ) + "</bFullTextEpgSearch>"        +
-								  "<strDirectory>"              +      timer.strDirectory                 + "</strDirectory>"              +
-								  "<strSummary>"                +            strSummary.c_str()           + "</strSummary>"                +
-								  "<iPriority>"                 + itos(timer.iPriority                  ) + "</iPriority>"                 +
-								  "<iLifetime>"                 + itos(timer.iLifetime                  ) + "</iLifetime>"                 +
-								  "<iMaxRecordings>"            + itos(timer.iMaxRecordings             ) + "</iMaxRecordings>"            +
-								  "<iRecordingGroup>"           + itos(timer.iRecordingGroup            ) + "</iRecordingGroup>"           +
-								  "<firstDay>"                  + itos(timer.firstDay                   ) + "</firstDay>"                  +
-								  "<iWeekdays>"                 + itos(PVR_WEEKDAY_NONE                 ) + "</iWeekdays>"                 +
-								  "<iPreventDuplicateEpisodes>" + itos(timer.iPreventDuplicateEpisodes  ) + "</iPreventDuplicateEpisodes>" +
-								  "<iEpgUid>"                   + itos(timer.iEpgUid                    ) + "</iEpgUid>"                   +
-								  "<iMarginStart>"              + itos(timer.iMarginStart               ) + "</iMarginStart>"              +
-								  "<iMarginEnd>"                + itos(timer.iMarginEnd                 ) + "</iMarginEnd>"                +
-								  "<iGenreType>"                + itos(timer.iGenreType                 ) + "</iGenreType>"                +
-								  "<iGenreSubType>"             + itos(timer.iGenreSubType              ) + "</iGenreSubType>"             +
-								  "<strSeriesLink>"             +      timer.strSeriesLink                + "</strSeriesLink>"             ;
+				string sqlTimer = "<iClientIndex>"              + itos(PVR_TIMER_NO_CLIENT_INDEX          ) + "</iClientIndex>"              +
+								  "<iParentClientIndex>"        + itos(timer.iClientIndex                 ) + "</iParentClientIndex>"        +
+								  "<iClientChannelUid>"         + itos(timer.iClientChannelUid            ) + "</iClientChannelUid>"         +
+								  "<startTime>"                 + itos(      startTime                    ) + "</startTime>"                 +
+								  "<endTime>"                   + itos(      endTime                      ) + "</endTime>"                   +
+								  "<bStartAnyTime>"             + btos(false                              ) + "</bStartAnyTime>"             +
+								  "<bEndAnyTime>"               + btos(false                              ) + "</bEndAnyTime>"               +
+								  "<state>"                     + itos(timer.state                        ) + "</state>"                     +
+								  "<iTimerType>"                + itos(TIMER_ONCE_MANUAL                  ) + "</iTimerType>"                +
+								  "<strTitle>"                  + EscapeSQLValue(timer.strTitle           ) + "</strTitle>"                  +
+								  "<strEpgSearchString>"        + EscapeSQLValue(timer.strEpgSearchString ) + "</strEpgSearchString>"        +
+								  "<bFullTextEpgSearch>"        + btos(timer.bFullTextEpgSearch           ) + "</bFullTextEpgSearch>"        +
+								  "<strDirectory>"              + EscapeSQLValue(timer.strDirectory       ) + "</strDirectory>"              +
+								  "<strSummary>"                + EscapeSQLValue(strSummary               ) + "</strSummary>"                +
+								  "<iPriority>"                 + itos(timer.iPriority                    ) + "</iPriority>"                 +
+								  "<iLifetime>"                 + itos(timer.iLifetime                    ) + "</iLifetime>"                 +
+								  "<iMaxRecordings>"            + itos(timer.iMaxRecordings               ) + "</iMaxRecordings>"            +
+								  "<iRecordingGroup>"           + itos(timer.iRecordingGroup              ) + "</iRecordingGroup>"           +
+								  "<firstDay>"                  + itos(timer.firstDay                     ) + "</firstDay>"                  +
+								  "<iWeekdays>"                 + itos(PVR_WEEKDAY_NONE                   ) + "</iWeekdays>"                 +
+								  "<iPreventDuplicateEpisodes>" + itos(timer.iPreventDuplicateEpisodes    ) + "</iPreventDuplicateEpisodes>" +
+								  "<iEpgUid>"                   + itos(timer.iEpgUid                      ) + "</iEpgUid>"                   +
+								  "<iMarginStart>"              + itos(timer.iMarginStart                 ) + "</iMarginStart>"              +
+								  "<iMarginEnd>"                + itos(timer.iMarginEnd                   ) + "</iMarginEnd>"                +
+								  "<iGenreType>"                + itos(timer.iGenreType                   ) + "</iGenreType>"                +
+								  "<iGenreSubType>"             + itos(timer.iGenreSubType                ) + "</iGenreSubType>"             +
+								  "<strSeriesLink>"             + EscapeSQLValue(timer.strSeriesLink      ) + "</strSeriesLink>"             ;
 								  
 				// create container
 				DVRTimer cTimer(sqlTimer);
@@ -2319,47 +4319,20 @@ PVR_ERROR SQLConnection::ScheduleTimer(const PVR_TIMER &timer)
 		}
 	}
   
-	// remove if already scheduled 
-	for (vector<DVRTimer>::iterator cSchedule = cSchedules.begin(); cSchedule != cSchedules.end(); cSchedule++)
-	{
-		// check current timers
-		for (vector<SQLRecord>::iterator sqlTimer = sqlTimers.begin(); sqlTimer != sqlTimers.end(); sqlTimer++)
-		{
-			// convert to c type
-			DVRTimer cTimer(sqlTimer->GetRecord());
-			
-			// skip un-scheduled timers
-			if (cTimer.GetState() == PVR_TIMER_STATE_SCHEDULED || cTimer.GetState() == PVR_TIMER_STATE_RECORDING || cTimer.GetState() == PVR_TIMER_STATE_COMPLETED || cTimer.GetState() == PVR_TIMER_STATE_ABORTED)
-			{
-				// only look for manual timers
-				if (cTimer.GetTimerType() == TIMER_ONCE_MANUAL || cTimer.GetTimerType() == TIMER_ONCE_EPG)
-				{
-					// remove if found
-					if (cSchedule->GetClientChannelUid() == cTimer.GetClientChannelUid() &&
-					    cSchedule->GetStartTime()        == cTimer.GetStartTime()        &&
-					    cSchedule->GetEndTime()          == cTimer.GetEndTime()            )
-					{
-						// remove
-						cSchedules.erase(cSchedule--);
-					}
-				}
-			}
-		}
-	}
-	  
 	// setup schedule adjuster
 	int iIndex = 1;
 	  
-	// add timers from schedule, pass index to adjust id
+	// add timers from schedule, pass index to adjust id (kept in current timers so later rules see them)
 	for (vector<DVRTimer>::iterator cSchedule = cSchedules.begin(); cSchedule != cSchedules.end(); cSchedule++)
+	{
 		if (cSchedule->GetState() == PVR_TIMER_STATE_SCHEDULED)
+		{
 			this->AddTimer(cSchedule->Timer(), iIndex++);
+			cTimers.push_back(*cSchedule);
+		}
+	}
 	  
 	// clear containers
-	sqlEpgEntries.clear();
-	sqlEpgChannels.clear();
-	sqlChannels.clear();
-	sqlTimers.clear();
 	cSchedules.clear();
 
 	// return no issue
@@ -21,6 +21,14 @@
 /***********************************************************
  * Headers
  ***********************************************************/
+#include <thread>
+#include <atomic>
+#include <unordered_set>
+#include <queue>
+#include <functional>
+#include <condition_variable>
+#include <chrono>
+
 #include "../client.h"
 #include "sqlite/sqlite3.h"
 #include "p8-platform/threads/threads.h"
@@ -28,10 +36,17 @@
 #include "PVRTypes.h"
 #include "PVRRecorder.h"
 #include "data/SQLRecord.h"
+#include "data/SQLRow.h"
+#include "data/SQLCursor.h"
+#include "data/IPTVChannel.h"
+#include "data/IPTVEpgChannel.h"
+#include "data/IPTVEpgEntry.h"
+#include "data/DVRTimer.h"
 #include "utilities/FileHelpers.h"
 #include "utilities/M3UHelpers.h"
 #include "utilities/GZHelpers.h"
 #include "utilities/XMLHelpers.h"
+#include "utilities/XMLReader.h"
 #include "utilities/SQLHelpers.h"
 #include "utilities/Utilities.h"
 
@@ -57,6 +72,7 @@ class SQLConnection : P8PLATFORM::CThread
 	public:
 		bool   IsConnected(void);
 		bool   IsWorking  (void);
+		bool   IsLoading  (void);
 		time_t LastM3URead(void);
 		time_t LastEPGRead(void);
 		int    GetEPGDays (void);
@@ -64,32 +80,106 @@ class SQLConnection : P8PLATFORM::CThread
 		
 	/* record api calls */
 	public:
-		void AddRecord   (const char*, const string, SQLRecord* = NULL        );
-		void UpdateRecord(const char*, const string, SQLRecord* = NULL        );
-		void DeleteRecord(const char*, const string                           );
-		bool FindRecord  (const char*, const char* , const int    , SQLRecord&);
-		bool FindRecord  (const char*, const char* , const char*  , SQLRecord&);
-		bool FindRecord  (const char*, const string,                SQLRecord&);
-		int  GetTableSize(const char*                                         );
-		
-	/* fetch table api calls */
+		void AddRecord   (const char*, const string, SQLRecord* = NULL                 );
+		void AddRecord   (const char*, const string, const vector<SQLValue>&           );
+		void AddRecords  (const char*, const string, const vector<vector<SQLValue> >&  );
+		void UpdateRecord(const char*, const string, SQLRecord* = NULL                 );
+		void UpdateRecord(const char*, const string, const vector<SQLValue>&           );
+		void DeleteRecord(const char*, const string                                    );
+		bool FindRecord  (const char*, const char* , const int    , SQLRecord&         );
+		bool FindRecord  (const char*, const char* , const char*  , SQLRecord&         );
+		bool FindRecord  (const char*, const string,                SQLRecord&         );
+		int  GetTableSize(const char*                                                  );
+		
+	/* fetch table api calls (cursor holds a reader until last row, no reads or writes inside loop) */
+	public:
+		bool GetRecords(const char*, SQLCursor&);
+		
+	/* fetch guide api calls (one tvg id between two times, or one tvg id matching a column not ended) */
+	public:
+		bool GetEpgEntries(const char*, const time_t, const time_t, SQLCursor&              );
+		bool GetEpgEntries(const char*, const char* , const string, const time_t, SQLCursor&);
+		
+	/* fetch change journal api calls (latest change per row after a sequence) */
 	public:
-		vector<SQLRecord> GetRecords(const char*);
+		bool GetChanges(const char*, const long long, SQLCursor&);
+		
+	/* fetch typed table api calls */
+	public:
+		bool GetRecords(const char*, vector<IPTVChannel   >&);
+		bool GetRecords(const char*, vector<IPTVEpgChannel>&);
+		bool GetRecords(const char*, vector<IPTVEpgEntry  >&);
+		bool GetRecords(const char*, vector<DVRTimer      >&);
 		
 	/* connect/disconnect */
 	private:
 		void Connect   (void       );
 		void Disconnect(bool = true);
+		
+	/* reader pool functions (read only connections beside the writer) */
+	private:
+		void       OpenReaders (void      );
+		void       CloseReaders(void      );
+		SQLReader* LockReader  (void      );
+		void       UnlockReader(SQLReader*);
+		
+	/* transaction functions (writer lock held from begin to end so other writes never join, end commits unless told to roll back) */
+	private:
+		void BeginTransaction(void       );
+		void EndTransaction  (bool = true);
 	
 	/* query functions (mutex lock for callback vector */
 	private:
 	    friend int cCallback(      void*, int   , char**, char**);
 		       int Callback (      int  , char**, char**        );
 		       int SendQuery(const char*, void*                 );
+		
+	/* prepared query functions (mutex lock for statement cache) */
+	private:
+		sqlite3_stmt* PrepareQuery (const string , SQLReader* = NULL       );
+		void          BindQuery    (sqlite3_stmt*, const vector<SQLValue>& );
+		int           StepQuery    (sqlite3_stmt*, void*                   );
+		void          ClearQueries (SQLReader* = NULL                      );
+		
+	/* typed query functions (mutex lock for statement cache) */
+	private:
+		template <class T> bool FetchRecords(const char*, vector<T>&);
+		
+	/* change log functions */
+	private:
+		void UpdateDBLog (const char*);
+		int  ResetJournal(const char*);
+		void PruneJournal(void       );
 				
 	/* sql server */
 	private:
 		void *Process(void);
+		
+	/* loader functions (playlist and guide imports on own thread so deadlines keep being served) */
+	private:
+		void LoadSources(void        );
+		void WakeLoader (void        );
+		void WaitLoader (const time_t);
+		
+	/* timer schedule functions (deadlines reloaded when timers change, thread sleeps until next) */
+	private:
+		void WakeSchedule     (void             );
+		bool IsScheduleChanged(void             );
+		void WaitSchedule     (const time_t     );
+		void LoadSchedule     (vector<DVRTimer>&);
+		void RunSchedule      (vector<DVRTimer>&);
+		void ExpandSchedule   (vector<DVRTimer>&);
+		
+	/* timer key functions (airings keyed by channel and times, episodes by title and number or name) */
+	private:
+		static string GetTimerKey  (const int   , const time_t          , const time_t             );
+		static string GetEpisodeKey(const string, const int             , const int   , const string);
+		       void   GetEpisodes  (const string, unordered_set<string>&                            );
+		
+	/* recording admission functions (recordings limited overall and per stream host, lower priority preempted) */
+	private:
+		string GetSource (const int                   );
+		bool   AdmitTimer(DVRTimer&, vector<DVRTimer>&);
 			
 	/* create table functions */
 	private:
@@ -101,17 +191,32 @@ class SQLConnection : P8PLATFORM::CThread
 		bool CreateTimerTypes         (void);
 		bool CreateTimers             (void);
 		bool CreateRecordings         (void);
+		
+	/* schema migration functions */
+	private:
+		bool CreateSchemaVersion(void                            );
+		int  GetSchemaVersion   (void                            );
+		bool ApplyMigration     (const int, const vector<string>&);
+		bool MigrateSchema      (void                            );
 			
 	/* clear and clean functions */
 	private:
-		void ClearChannels           (void);
-		void ClearChannelGroups      (void);
-		void ClearChannelGroupMembers(void);
-		void ClearGuideChannels      (void);
-		void ClearGuideEntries       (void);
-		void ClearTimerTypes         (void);
-		void CleanTimers             (void);
-		void CleanRecordings         (void);
+		void ClearTimerTypes(void);
+		void CleanTimers    (void);
+		void CleanRecordings(void);
+		void CleanEpgEntries(void);
+		
+	/* staging table functions (imports fill copies swapped or merged in as one) */
+	private:
+		bool CreateStaging(const vector<string>&);
+		bool SwapStaging  (const vector<string>&);
+		bool MergeStaging (const vector<string>&);
+		void DropStaging  (const vector<string>&);
+		
+	/* source cache functions (remote files copied as hashed, unchanged content skips import) */
+	private:
+		bool FetchSource(const string, const bool, const string, string&, SQLSource&);
+		void SaveSource (const SQLSource&                                          );
 		
 	/* import functions */
 	private:
@@ -119,33 +224,72 @@ class SQLConnection : P8PLATFORM::CThread
 		void ImportXMLTV     (void);
 		void ImportTimerTypes(void);
 		
+	/* guide decode functions (workers started once per import take chunks of queued batch while import thread reads and writes) */
+	private:
+		static void StartDecode   (SQLDecodeQueue&, vector<thread>&                                 );
+		static void QueueDecode   (SQLDecodeQueue&, const vector<string>*, vector<SQLEpgRow>*       );
+		static void WaitDecode    (SQLDecodeQueue&                                                  );
+		static void StopDecode    (SQLDecodeQueue&, vector<thread>&                                 );
+		static void DecodeWorker  (SQLDecodeQueue*                                                  );
+		static void DecodeEpgSlice(const vector<string>*, vector<SQLEpgRow>*, const size_t, const size_t);
+		
 	/* filter channels */
 	private:
 		void FilterChannelsEPG(void);
 		
 	/* scheduler functions */
 	private:
-		PVR_ERROR AddTimer     (const PVR_TIMER&  , int  = 0    );
-		PVR_ERROR DeleteTimer  (const PVR_TIMER&  , bool = false);
-		PVR_ERROR StartTimer   (const PVR_TIMER&                );
-		PVR_ERROR StopTimer    (const PVR_TIMER&                );
-		PVR_ERROR ScheduleTimer(const PVR_TIMER&                );
+		PVR_ERROR AddTimer     (const PVR_TIMER&  , int  = 0         );
+		PVR_ERROR DeleteTimer  (const PVR_TIMER&  , bool = false     );
+		PVR_ERROR StartTimer   (const PVR_TIMER&                     );
+		PVR_ERROR StopTimer    (const PVR_TIMER&  , PVR_TIMER_STATE = PVR_TIMER_STATE_COMPLETED);
+		PVR_ERROR ScheduleTimer(const PVR_TIMER&  , vector<DVRTimer>&);
 		
 	/* server variables */
 	private:
-		bool     bIsConnected;
-		bool     bIsWorking  ;
-		bool     bStop       ;
-		time_t   tLastM3URead;
-		time_t   tLastEPGRead;
-		int      iNumEPGDays ;
-		string   strDBPath   ;
-		sqlite3 *sqlDatabase ;
-		mutex    pMutex      ;
+		bool     bIsConnected ;
+		bool     bIsWorking   ;
+		bool     bStop        ;
+		time_t   tLastM3URead ;
+		time_t   tLastEPGRead ;
+		time_t   tLastEPGClean;
+		int      iNumEPGDays  ;
+		string   strDBPath    ;
+		sqlite3 *sqlDatabase  ;
+		mutex    pMutex       ;
 		
 	/* callback & recorder variables */
 	private:
 		vector<SQLRecord> sqlCallback;
 		vector<SQLMsg   > sqlLog     ;
 		vector<SQLTask  > sqlTasks   ;
+		
+	/* prepared statement variables */
+	private:
+		map<string, sqlite3_stmt*> sqlStatements;
+		
+	/* reader pool variables */
+	private:
+		vector<SQLReader*> sqlReaders;
+		mutex              pReadMutex;
+		int                iNextRead ;
+		
+	/* loader variables */
+	private:
+		thread             tLoader   ;
+		condition_variable cLoad     ;
+		mutex              pLoadMutex;
+		atomic<bool>       bIsLoading;
+		
+	/* timer schedule variables */
+	private:
+		priority_queue<SQLDeadline, vector<SQLDeadline>, greater<SQLDeadline> > sqlDeadlines    ;
+		condition_variable                                                      cSchedule       ;
+		mutex                                                                   pScheduleMutex  ;
+		bool                                                                    bScheduleChanged;
+		
+	/* timer rule variables (guide sequence and rule fields at last expansion) */
+	private:
+		long long                  iExpandSequence;
+		map<unsigned int, string>  strExpandKeys  ;
 };
\ No newline at end of file
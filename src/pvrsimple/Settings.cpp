@@ -40,6 +40,8 @@ PVRSettings::PVRSettings(void)
 	iEPGTimeShift      = 0.0                   ;
 	iEPGRefresh        = REFRESH_INTERVAL_START;
 	bEPGTSOverride     = false                 ;
+	iEPGPastDays       = 1                     ;
+	iEPGFutureDays     = 14                    ;
 	iLogoPathType      = 0                     ;
 	strLogoPath        = ""                    ;
 	iLogoFromEPG       = LOGO_PREFERENCE_IGNORE;
@@ -53,6 +55,9 @@ PVRSettings::PVRSettings(void)
 	strFileExt         = ""                    ;
 	iStrmTimeout       = 60                    ;
 	iStrmQuality       = 1                     ;
+	iMaxRecords        = 0                     ;
+	iMaxStreams        = 0                     ;
+	iPreRoll           = 15                    ;
 	strUserPath        = ""                    ;
 	strClientPath      = ""                    ;
 	  
@@ -77,6 +82,15 @@ string PVRSettings::GetM3UPath(void)
 	return strM3UPath;
 }
 
+bool PVRSettings::GetM3UCache(void)
+{
+	// log function call
+	CPPLog(); 
+	  
+	// return settings
+	return bM3UCache;
+}
+
 int PVRSettings::GetM3UStartNum(void)
 {
 	// log function call
@@ -116,6 +130,15 @@ string PVRSettings::GetEPGPath(void)
 	return strEPGPath;
 }
 
+bool PVRSettings::GetEPGCache(void)
+{
+	// log function call
+	CPPLog(); 
+	  
+	// return settings
+	return bEPGCache;
+}
+
 float PVRSettings::GetEPGTimeShift(void)
 {
 	// log function call
@@ -143,6 +166,24 @@ bool PVRSettings::GetEPGTSOverride(void)
 	return bEPGTSOverride;
 }
 
+int PVRSettings::GetEPGPastDays(void)
+{
+	// log function call
+	CPPLog(); 
+	  
+	// return settings
+	return iEPGPastDays;
+}
+
+int PVRSettings::GetEPGFutureDays(void)
+{
+	// log function call
+	CPPLog(); 
+	  
+	// return settings
+	return iEPGFutureDays;
+}
+
 /***********************************************************
  * Channel Logos Definitions
  ***********************************************************/
@@ -248,6 +289,33 @@ int PVRSettings::GetStrmTimeout(void)
 	return iStrmTimeout;
 }
 
+int PVRSettings::GetMaxRecords(void)
+{
+	// log function call
+	CPPLog(); 
+	  
+	// return settings (zero is unlimited)
+	return iMaxRecords;
+}
+
+int PVRSettings::GetMaxStreams(void)
+{
+	// log function call
+	CPPLog(); 
+	  
+	// return settings (zero is unlimited)
+	return iMaxStreams;
+}
+
+int PVRSettings::GetPreRoll(void)
+{
+	// log function call
+	CPPLog(); 
+	  
+	// return settings (seconds recorder connects ahead of start margin)
+	return iPreRoll;
+}
+
 /***********************************************************
  * Special Paths Definitions
  ***********************************************************/
@@ -357,6 +425,8 @@ void PVRSettings::LoadSettings(void)
 	if (XBMC->GetSetting("epg.time.shift"     , &fBuffer)) { iEPGTimeShift  = fBuffer; }
 	if (XBMC->GetSetting("epg.refresh"        , &iBuffer)) { iEPGRefresh    = iBuffer; }
 	if (XBMC->GetSetting("epg.ts.override"    , &bBuffer)) { bEPGTSOverride = bBuffer; }
+	if (XBMC->GetSetting("epg.past.days"      , &iBuffer)) { iEPGPastDays   = iBuffer; }
+	if (XBMC->GetSetting("epg.future.days"    , &iBuffer)) { iEPGFutureDays = iBuffer; }
 	  
 	// read in logo settings
 	if (XBMC->GetSetting("logo.path.type"     , &iBuffer)) { iLogoPathType  = iBuffer; }
@@ -393,6 +463,9 @@ void PVRSettings::LoadSettings(void)
 	if (XBMC->GetSetting("dvr.file.ext"       , &cBuffer)) { strFileExt     = cBuffer; }
 	if (XBMC->GetSetting("dvr.stream.timeout" , &iBuffer)) { iStrmTimeout   = iBuffer; }
 	if (XBMC->GetSetting("dvr.stream.quality" , &iBuffer)) { iStrmQuality   = iBuffer; }
+	if (XBMC->GetSetting("dvr.max.records"    , &iBuffer)) { iMaxRecords    = iBuffer; }
+	if (XBMC->GetSetting("dvr.max.streams"    , &iBuffer)) { iMaxStreams    = iBuffer; }
+	if (XBMC->GetSetting("dvr.preroll"        , &iBuffer)) { iPreRoll       = iBuffer; }
 	  
 		 
 	// log settings loaded
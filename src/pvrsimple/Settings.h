@@ -43,15 +43,19 @@ class PVRSettings
 
 	public:
 		string GetM3UPath    (void);
+		bool   GetM3UCache   (void);
 		int    GetM3UStartNum(void);
 		int    GetM3URefresh (void);
 		bool   GetM3UFilter  (void);
 	  
 	public:
 		string GetEPGPath      (void);
+		bool   GetEPGCache     (void);
 		float  GetEPGTimeShift (void);
 		int    GetEPGRefresh   (void);
 		bool   GetEPGTSOverride(void);
+		int    GetEPGPastDays  (void);
+		int    GetEPGFutureDays(void);
 	  
 	public:
 		string GetLogoPath(void);
@@ -67,6 +71,9 @@ class PVRSettings
 		string GetAVParams   (void);
 		string GetFileExt    (void);
 		int    GetStrmTimeout(void);
+		int    GetMaxRecords (void);
+		int    GetMaxStreams (void);
+		int    GetPreRoll    (void);
 		
 	public:
 		void   SetClientPath(string);
@@ -90,6 +97,8 @@ class PVRSettings
 		float  iEPGTimeShift ;
 		int    iEPGRefresh   ;
 		bool   bEPGTSOverride;
+		int    iEPGPastDays  ;
+		int    iEPGFutureDays;
 		int    iLogoPathType ;
 		string strLogoPath   ;
 		int    iLogoFromEPG  ;
@@ -103,6 +112,9 @@ class PVRSettings
 		string strFileExt    ;
 		int    iStrmTimeout  ;
 		int    iStrmQuality  ;
+		int    iMaxRecords   ;
+		int    iMaxStreams   ;
+		int    iPreRoll      ;
 		string strUserPath   ;
 		string strClientPath ;
 };
\ No newline at end of file
@@ -37,9 +37,10 @@ TCPClient::TCPClient()
 	// log attempt to create object
 	XBMC->Log(LOG_NOTICE, "C+: %s - Creating TCP client", __FUNCTION__);
 	
-	// no establish connection at start
+	// no establish connection at start (loading state read from backend log)
 	bIsConnected = false;
 	bIsWorking   = false;
+	bIsLoading   = false;
 	bStop        = false;
 	
 	// log connection attempt
@@ -85,6 +86,15 @@ bool TCPClient::IsWorking(void)
 	return bIsWorking;
 }
 
+bool TCPClient::IsLoading(void)
+{
+	// log function call
+	CPPLog(); 
+	
+	// return value
+	return bIsLoading;
+}
+
 /***********************************************************
  * Records API Definitions
  ***********************************************************/
@@ -177,59 +187,86 @@ void TCPClient::UpdateRecord(const char* strTable, const string strRecord, SQLRe
 /***********************************************************
  * Tables API Definitions
  ***********************************************************/
-vector<SQLRecord> TCPClient::GetRecords(const char* strTable)
+bool TCPClient::GetRecords(const char* strTable, SQLCursor& sqlCursor)
 {
 	// log function call
 	CPPLog(); 
 	
-	// create return vector
-	vector<SQLRecord> sqlReturn;
+	// create http request
+	string strRequest = string("GET /GetRecords(\"") + string(strTable) + string("\") HTTP/1.1\r\n\r\n");
 	
-	// clear container
-	sqlReturn.clear();
+	// send request and open cursor on response
+	return OpenCursor(strRequest, sqlCursor);
+}
+
+/***********************************************************
+ * Guide API Definitions
+ ***********************************************************/
+bool TCPClient::GetEpgEntries(const char* strTvgId, const time_t iStart, const time_t iEnd, SQLCursor& sqlCursor)
+{
+	// log function call
+	CPPLog(); 
 	
-	// create connection
-	tcp_client_t tcpClient(settings->GetServerIP().c_str(), settings->GetServerPort());
+	// create http request (tvg id escaped so it cannot break the request line)
+	string strRequest = string("GET /GetEpgEntries(") + to_string((long long)iStart) + string(", ") + to_string((long long)iEnd) + string(", \"") + EscapeSQLValue(strTvgId) + string("\") HTTP/1.1\r\n\r\n");
+	
+	// send request and open cursor on response
+	return OpenCursor(strRequest, sqlCursor);
+}
+
+/***********************************************************
+ * Change Journal API Definitions
+ ***********************************************************/
+bool TCPClient::GetChanges(const char* strTable, const long long iSequence, SQLCursor& sqlCursor)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create http request
+	string strRequest = string("GET /GetChanges(\"") + string(strTable) + string("\", ") + to_string(iSequence) + string(") HTTP/1.1\r\n\r\n");
+	
+	// send request and open cursor on response
+	return OpenCursor(strRequest, sqlCursor);
+}
+
+/***********************************************************
+ * Stream Definitions
+ ***********************************************************/
+bool TCPClient::OpenCursor(const string strRequest, SQLCursor& sqlCursor)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create connection (owned by cursor once open)
+	tcp_client_t *tcpClient = new tcp_client_t(settings->GetServerIP().c_str(), settings->GetServerPort());
 	
 	// if connected check log
-	if (tcpClient.connect() >= 0)
+	if (tcpClient->connect() >= 0)
 	{
-		// create buffer for request
-		char strRequest[1024];	
-
-		// create http request
-		sprintf(strRequest, "GET /GetRecords(\"%s\") HTTP/1.1\r\n\r\n", strTable);
-		
 		// send to client and fetch response
-		if(tcpClient.write_all(strRequest, strlen(strRequest)) >= 0)
+		if(tcpClient->write_all(strRequest.c_str(), strRequest.size()) >= 0)
 		{
 			// prepare for response
-			string strResponse;
+			string strHeader;
 			
-			// get respone
-			if (http_get_response(tcpClient, strResponse) > 0)
+			// read header and hand body to cursor
+			if (parse_http_headers(tcpClient->m_sockfd, strHeader) > 0)
 			{
-				// parse response
-				vector<string> strLog = StringUtils::Split(strResponse, "\n");
+				// open cursor on connection
+				sqlCursor.Open(tcpClient);
 				
-				// iterate and trigger update
-				for (vector<string>::iterator strMsg = strLog.begin(); strMsg != strLog.end(); strMsg++)
-				{
-					// create records from message string
-					SQLRecord sqlRecord(*strMsg);
-					
-					// add to return vector
-					sqlReturn.push_back(sqlRecord);
-				}
+				// return status
+				return true;
 			}
 		}	
 	}
 
 	// close connection
-	tcpClient.close();
+	tcpClient->close();
+	delete tcpClient;
 			
-	// return container
-	return sqlReturn;
+	// return status
+	return false;
 }
 
 /***********************************************************
@@ -335,25 +372,50 @@ void *TCPClient::Process(void)
 							// create message from string
 							SQLMsg sqlMsg;
 							
-							sqlMsg.strTable =      ParseSQLValue(*strMsg, "<strTable>", "") ; 
-							sqlMsg.iModTime = stoi(ParseSQLValue(*strMsg, "<iModTime>",  0)); 
+							sqlMsg.strTable  =       ParseSQLValue(*strMsg, "<strTable>" , "") ; 
+							sqlMsg.iModTime  = stoi (ParseSQLValue(*strMsg, "<iModTime>" ,  0)); 
+							sqlMsg.iSequence = stoll(ParseSQLValue(*strMsg, "<iSequence>",  0)); 
 							
 							// check for changes		
-							if (sqlMsg.strTable == "Channels"  )
+							if (sqlMsg.strTable == "Channels" || sqlMsg.strTable == "ChannelGroups" || sqlMsg.strTable == "ChannelGroupMembers")
 								if (iptv->LastChannelsSync()   < sqlMsg.iModTime) 
 									{XBMC->Log(LOG_NOTICE, "C+: %s - The channels were updated on the backend, proceed to sync"   , __FUNCTION__); iptv->TriggerChannelsUpdate (sqlMsg.iModTime);}
 
 							if (sqlMsg.strTable == "EpgEntries")
-								if (iptv->LastEpgEntriesSync() < sqlMsg.iModTime) 
+								if (iptv->LastEpgEntriesSequence() < sqlMsg.iSequence) 
 									{XBMC->Log(LOG_NOTICE, "C+: %s - The epg entries were updated on the backend, proceed to sync", __FUNCTION__); iptv->TriggerEpgUpdate      (sqlMsg.iModTime);}
 								
 							if (sqlMsg.strTable == "Timers"    )
-								if (dvr->LastTimersSync()      < sqlMsg.iModTime) 
+								if (dvr->LastTimersSequence()  < sqlMsg.iSequence) 
 									{XBMC->Log(LOG_NOTICE, "C+: %s - The timers were updated on the backend, proceed to sync"     , __FUNCTION__); dvr->TriggerTimersUpdate    (sqlMsg.iModTime);}
 								
 							if (sqlMsg.strTable == "Recordings")
 								if (dvr->LastRecordingsSync()  < sqlMsg.iModTime) 
 									{XBMC->Log(LOG_NOTICE, "C+: %s - The recordings were updated on the backend, proceed to sync" , __FUNCTION__); dvr->TriggerRecordingsUpdate(sqlMsg.iModTime);}
+							
+							// check for backend state (tables above trigger sync once load completes)
+							if (sqlMsg.strTable == "Backend")
+							{
+								// read loading state
+								bool bLoading = stob(ParseSQLValue(*strMsg, "<bIsLoading>", "false"));
+								
+								// notify on screen if started loading
+								if (bLoading && !bIsLoading)
+								{
+									PVR->ConnectionStateChange("Loading", PVR_CONNECTION_STATE_CONNECTING, "DVR loading");
+									XBMC->Log(LOG_NOTICE, "C+: %s - The backend is loading playlist and guide", __FUNCTION__);
+								}
+								
+								// notify on screen if done loading
+								if (!bLoading && bIsLoading)
+								{
+									PVR->ConnectionStateChange("Connected", PVR_CONNECTION_STATE_CONNECTED, "DVR loaded");
+									XBMC->Log(LOG_NOTICE, "C+: %s - The backend loaded playlist and guide", __FUNCTION__);
+								}
+								
+								// set loading state
+								bIsLoading = bLoading;
+							}
 						}
 						
 						// log last check
@@ -27,6 +27,7 @@
 #include "p8-platform/threads/threads.h"
 
 #include "data/SQLRecord.h"
+#include "data/SQLCursor.h"
 #include "utilities/HTTPHelpers.h"
 #include "utilities/Utilities.h"
 
@@ -50,15 +51,28 @@ class TCPClient : P8PLATFORM::CThread
 	public:
 		bool IsConnected (void);
 		bool IsWorking   (void);
+		bool IsLoading   (void);
 	
 	/* record api calls */
 	public:
 		void AddRecord   (const char*, const string, SQLRecord* = NULL);
 		void UpdateRecord(const char*, const string, SQLRecord* = NULL);
 		
-	/* fetch table api calls */
+	/* fetch table api calls (cursor reads rows from socket as they arrive) */
 	public:
-		vector<SQLRecord> GetRecords(const char*);
+		bool GetRecords(const char*, SQLCursor&);
+		
+	/* fetch guide api calls (one tvg id between two times) */
+	public:
+		bool GetEpgEntries(const char*, const time_t, const time_t, SQLCursor&);
+		
+	/* fetch change journal api calls (latest change per row after a sequence) */
+	public:
+		bool GetChanges(const char*, const long long, SQLCursor&);
+		
+	/* stream functions */
+	private:
+		bool OpenCursor(const string, SQLCursor&);
 		
 	/* connect/disconnect */
 	private:
@@ -73,6 +87,7 @@ class TCPClient : P8PLATFORM::CThread
 	private:
 		bool   bIsConnected   ;
 		bool   bIsWorking     ;
+		bool   bIsLoading     ;
 		bool   bStop          ;
 		mutex  pMutex         ;
 };
\ No newline at end of file
@@ -197,7 +197,7 @@ string TCPServer::UpdateRecord(const string strAction)
 /***********************************************************
  * Tables API Definitions
  ***********************************************************/
-string TCPServer::GetRecords(const string strAction)
+void TCPServer::GetRecords(net_socket_t& tcpSocket, const string strAction)
 {
 	// log function call
 	CPPLog(); 
@@ -205,31 +205,100 @@ string TCPServer::GetRecords(const string strAction)
 	// parse call arguments
 	vector<string> vArgs = http_get_argument(strAction);
 	
-	// send equivalent to sqlite
-	vector<SQLRecord> sqlRecords = sqlite->GetRecords(vArgs[0].c_str());
+	// open cursor on table
+	SQLCursor sqlCursor;
+	sqlite->GetRecords(vArgs[0].c_str(), sqlCursor);
+	
+	// send rows to client
+	SendCursor(tcpSocket, sqlCursor);
+}
 
-	// create response
-	string strMsg = "";
+/***********************************************************
+ * Guide API Definitions
+ ***********************************************************/
+void TCPServer::GetEpgEntries(net_socket_t& tcpSocket, const string strAction)
+{
+	// log function call
+	CPPLog(); 
 	
-	// iterate through records
-	for (vector<SQLRecord>::iterator sqlRecord = sqlRecords.begin(); sqlRecord != sqlRecords.end(); sqlRecord++)
-		strMsg += sqlRecord->GetRecord()+"\n";
+	// create containers for window
+	long long iStart = 0;
+	long long iEnd   = 0;
 	
-	// delete last 2 characters (extra line break)
-	if(strMsg.size()) strMsg = strMsg.substr(0, strMsg.length()-2);
+	// parse call arguments (times first, quoted tvg id last as it may hold any character)
+	sscanf(strAction.c_str(), "GetEpgEntries(%lld, %lld, ", &iStart, &iEnd);
 	
-	// create response string
+	size_t iIdStart = strAction.find ('"');
+	size_t iIdEnd   = strAction.rfind('"');
+	
+	string strTvgId = (iIdStart != string::npos && iIdEnd > iIdStart) ? UnescapeSQLValue(strAction.substr(iIdStart + 1, iIdEnd - iIdStart - 1)) : "";
+	
+	// open cursor on window
+	SQLCursor sqlCursor;
+	sqlite->GetEpgEntries(strTvgId.c_str(), (time_t)iStart, (time_t)iEnd, sqlCursor);
+	
+	// send rows to client
+	SendCursor(tcpSocket, sqlCursor);
+}
+
+/***********************************************************
+ * Change Journal API Definitions
+ ***********************************************************/
+void TCPServer::GetChanges(net_socket_t& tcpSocket, const string strAction)
+{
+	// log function call
+	CPPLog(); 
+	
+	// parse call arguments (quoted table first, sequence after)
+	vector<string> vArgs = http_get_argument(strAction);
+	
+	// create container for sequence
+	long long iSequence = 0;
+	
+	// parse sequence following table
+	if (strAction.find("\",") != string::npos)
+		sscanf(strAction.substr(strAction.find("\",") + 2).c_str(), "%lld", &iSequence);
+	
+	// open cursor on changes
+	SQLCursor sqlCursor;
+	sqlite->GetChanges(vArgs.size() ? vArgs[0].c_str() : "", iSequence, sqlCursor);
+	
+	// send rows to client
+	SendCursor(tcpSocket, sqlCursor);
+}
+
+/***********************************************************
+ * Stream Definitions
+ ***********************************************************/
+void TCPServer::SendCursor(net_socket_t& tcpSocket, SQLCursor& sqlCursor)
+{
+	// log function call
+	CPPLog(); 
+	
+	// create response string (no length, body ends when connection closes)
 	string strResponse("HTTP/1.1 200 OK\r\n");
 
 	// construct proper http
-	strResponse += "Content-Length: ";
-	strResponse += to_string(strMsg.size());
+	strResponse += "Connection: close";
 	strResponse += "\r\n";
 	strResponse += "\r\n";
-	strResponse += strMsg;
 	
-	// return response for client
-	return strResponse;
+	// iterate through records (one line each, sent in blocks)
+	while (sqlCursor.Next())
+	{
+		// add record to block
+		strResponse += sqlCursor.GetRow().GetRecord()+"\n";
+		
+		// send full block
+		if (strResponse.size() >= SERVER_BUFFER_SIZE)
+		{
+			tcpSocket.write_all(strResponse.c_str(), strResponse.size());
+			strResponse.clear();
+		}
+	}
+	
+	// send last block
+	tcpSocket.write_all(strResponse.c_str(), strResponse.size());
 }
 
 /***********************************************************
@@ -322,10 +391,12 @@ void *TCPServer::Process(void)
 			if (strMethod.compare("GET") == 0)
 			{
 				// call api equivalent
-				if      (StringUtils::StartsWith(strAction, "GetDBLog"    )){string strResponse = GetDBLog    (         ); tcpSocket.write_all(strResponse.c_str(), strResponse.size());}
-				else if (StringUtils::StartsWith(strAction, "AddRecord"   )){string strResponse = AddRecord   (strAction); tcpSocket.write_all(strResponse.c_str(), strResponse.size());}
-				else if (StringUtils::StartsWith(strAction, "UpdateRecord")){string strResponse = UpdateRecord(strAction); tcpSocket.write_all(strResponse.c_str(), strResponse.size());}
-				else if (StringUtils::StartsWith(strAction, "GetRecords"  )){string strResponse = GetRecords  (strAction); tcpSocket.write_all(strResponse.c_str(), strResponse.size());}
+				if      (StringUtils::StartsWith(strAction, "GetDBLog"     )){string strResponse = GetDBLog     (         ); tcpSocket.write_all(strResponse.c_str(), strResponse.size());}
+				else if (StringUtils::StartsWith(strAction, "AddRecord"    )){string strResponse = AddRecord    (strAction); tcpSocket.write_all(strResponse.c_str(), strResponse.size());}
+				else if (StringUtils::StartsWith(strAction, "UpdateRecord" )){string strResponse = UpdateRecord (strAction); tcpSocket.write_all(strResponse.c_str(), strResponse.size());}
+				else if (StringUtils::StartsWith(strAction, "GetRecords"   )){                     GetRecords   (tcpSocket, strAction);                                                }
+				else if (StringUtils::StartsWith(strAction, "GetEpgEntries")){                     GetEpgEntries(tcpSocket, strAction);                                                }
+				else if (StringUtils::StartsWith(strAction, "GetChanges"   )){                     GetChanges   (tcpSocket, strAction);                                                }
 			}
 		}
 
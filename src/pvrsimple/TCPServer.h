@@ -27,6 +27,7 @@
 #include "p8-platform/threads/threads.h"
 
 #include "data/SQLRecord.h"
+#include "data/SQLCursor.h"
 #include "utilities/HTTPHelpers.h"
 #include "utilities/Utilities.h"
 
@@ -60,9 +61,15 @@ class TCPServer : P8PLATFORM::CThread
 		string AddRecord   (const string);
 		string UpdateRecord(const string);
 		
-	/* fetch table api calls */
+	/* fetch table api calls (rows written to socket as read) */
 	public:
-		string GetRecords(const string);
+		void GetRecords   (net_socket_t&, const string);
+		void GetEpgEntries(net_socket_t&, const string);
+		void GetChanges   (net_socket_t&, const string);
+		
+	/* stream functions */
+	private:
+		void SendCursor(net_socket_t&, SQLCursor&);
 
 	/* connect/disconnect */
 	private:
@@ -25,37 +25,42 @@
 /***********************************************************
  * Constructor/Destructor Definitions
  ***********************************************************/
-DVRRecording::DVRRecording(string strData)
+DVRRecording::DVRRecording(string strData) : DVRRecording(SQLRow(strData))
+{
+	// decode record in one pass
+}
+
+DVRRecording::DVRRecording(const SQLRow& sqlRow)
 {
 	// assign data to structure	
-	strRecordingId      =      ParseSQLValue(strData, "<strRecordingId>"     ,    "") ;
-	strTitle            =      ParseSQLValue(strData, "<strTitle>"           ,    "") ;
-	strEpisodeName      =      ParseSQLValue(strData, "<strEpisodeName>"     ,    "") ;
-	iSeriesNumber       = stoi(ParseSQLValue(strData, "<iSeriesNumber>"      ,     0));
-	iEpisodeNumber      = stoi(ParseSQLValue(strData, "<iEpisodeNumber>"     ,     0));
-	iYear               = stoi(ParseSQLValue(strData, "<iYear>"              ,     0));
-	strDirectory        =      ParseSQLValue(strData, "<strDirectory>"       ,    "") ;
-	strPlotOutline      =      ParseSQLValue(strData, "<strPlotOutline>"     ,    "") ;
-	strPlot             =      ParseSQLValue(strData, "<strPlot>"            ,    "") ;
-	strGenreDescription =      ParseSQLValue(strData, "<strGenreDescription>",    "") ;
-	strChannelName      =      ParseSQLValue(strData, "<strChannelName>"     ,    "") ;
-	strIconPath         =      ParseSQLValue(strData, "<strIconPath>"        ,    "") ;
-	strThumbnailPath    =      ParseSQLValue(strData, "<strThumbnailPath>"   ,    "") ;
-	strFanartPath       =      ParseSQLValue(strData, "<strFanartPath>"      ,    "") ;
-	recordingTime       = stoi(ParseSQLValue(strData, "<recordingTime>"      ,     0));
-	iDuration           = stoi(ParseSQLValue(strData, "<iDuration>"          ,     0));
-	iPriority           = stoi(ParseSQLValue(strData, "<iPriority>"          ,     0));
-	iLifetime           = stoi(ParseSQLValue(strData, "<iLifetime>"          ,     0));
-	iGenreType          = stoi(ParseSQLValue(strData, "<iGenreType>"         ,     0));
-	iGenreSubType       = stoi(ParseSQLValue(strData, "<iGenreSubType>"      ,     0));
-	iPlayCount          = stoi(ParseSQLValue(strData, "<iPlayCount>"         ,     0));
-	iLastPlayedPosition = stoi(ParseSQLValue(strData, "<iLastPlayedPosition>",     0));
-	bIsDeleted          = stob(ParseSQLValue(strData, "<bIsDeleted>"         , false));
-	iEpgEventId         = stoi(ParseSQLValue(strData, "<iEpgEventId>"        ,     0));
-	iChannelUid         = stoi(ParseSQLValue(strData, "<iChannelUid>"        ,     0));
-	channelType         = stoi(ParseSQLValue(strData, "<channelType>"        ,     0));
-	strFilePath         =      ParseSQLValue(strData, "<strFilePath>"        ,    "") ;
-	strFileName         =      ParseSQLValue(strData, "<strFileName>"        ,    "") ;
+	strRecordingId      = sqlRow.GetString("strRecordingId"     ,    "");
+	strTitle            = sqlRow.GetString("strTitle"           ,    "");
+	strEpisodeName      = sqlRow.GetString("strEpisodeName"     ,    "");
+	iSeriesNumber       = sqlRow.GetInt   ("iSeriesNumber"      ,     0);
+	iEpisodeNumber      = sqlRow.GetInt   ("iEpisodeNumber"     ,     0);
+	iYear               = sqlRow.GetInt   ("iYear"              ,     0);
+	strDirectory        = sqlRow.GetString("strDirectory"       ,    "");
+	strPlotOutline      = sqlRow.GetString("strPlotOutline"     ,    "");
+	strPlot             = sqlRow.GetString("strPlot"            ,    "");
+	strGenreDescription = sqlRow.GetString("strGenreDescription",    "");
+	strChannelName      = sqlRow.GetString("strChannelName"     ,    "");
+	strIconPath         = sqlRow.GetString("strIconPath"        ,    "");
+	strThumbnailPath    = sqlRow.GetString("strThumbnailPath"   ,    "");
+	strFanartPath       = sqlRow.GetString("strFanartPath"      ,    "");
+	recordingTime       = sqlRow.GetTime  ("recordingTime"      ,     0);
+	iDuration           = sqlRow.GetInt   ("iDuration"          ,     0);
+	iPriority           = sqlRow.GetInt   ("iPriority"          ,     0);
+	iLifetime           = sqlRow.GetInt   ("iLifetime"          ,     0);
+	iGenreType          = sqlRow.GetInt   ("iGenreType"         ,     0);
+	iGenreSubType       = sqlRow.GetInt   ("iGenreSubType"      ,     0);
+	iPlayCount          = sqlRow.GetInt   ("iPlayCount"         ,     0);
+	iLastPlayedPosition = sqlRow.GetInt   ("iLastPlayedPosition",     0);
+	bIsDeleted          = sqlRow.GetBool  ("bIsDeleted"         , false);
+	iEpgEventId         = sqlRow.GetInt   ("iEpgEventId"        ,     0);
+	iChannelUid         = sqlRow.GetInt   ("iChannelUid"        ,     0);
+	channelType         = sqlRow.GetInt   ("channelType"        ,     0);
+	strFilePath         = sqlRow.GetString("strFilePath"        ,    "");
+	strFileName         = sqlRow.GetString("strFileName"        ,    "");
 }
 
 DVRRecording::DVRRecording(void)
@@ -23,6 +23,8 @@
  ***********************************************************/
 #include <kodi/xbmc_pvr_types.h>
 
+#include "SQLRow.h"
+
 #include "../utilities/SQLHelpers.h"
 #include "../utilities/Utilities.h"
 
@@ -38,9 +40,10 @@ class DVRRecording
 {
 	/* constructors/destrctors */
 	public:
-		 DVRRecording(string);
-		 DVRRecording(void  );
-		~DVRRecording(void  );
+		 DVRRecording(string       );
+		 DVRRecording(const SQLRow&);
+		 DVRRecording(void         );
+		~DVRRecording(void         );
 		
 	/* operator overloads */
 	public:
@@ -25,36 +25,41 @@
 /***********************************************************
  * Constructor/Destructor Definitions
  ***********************************************************/
-DVRTimer::DVRTimer(string strData)
+DVRTimer::DVRTimer(string strData) : DVRTimer(SQLRow(strData))
+{
+	// decode record in one pass
+}
+
+DVRTimer::DVRTimer(const SQLRow& sqlRow)
 {
 	// assign data to structure	
-	iClientIndex              = stoi(ParseSQLValue(strData, "<iClientIndex>"             ,     0));
-	iParentClientIndex        = stoi(ParseSQLValue(strData, "<iParentClientIndex>"       ,     0));
-	iClientChannelUid         = stoi(ParseSQLValue(strData, "<iClientChannelUid>"        ,     0));
-	startTime                 = stoi(ParseSQLValue(strData, "<startTime>"                ,     0));
-	endTime                   = stoi(ParseSQLValue(strData, "<endTime>"                  ,     0));
-	bStartAnyTime             = stob(ParseSQLValue(strData, "<bStartAnyTime>"            , false));
-	bEndAnyTime               = stob(ParseSQLValue(strData, "<bEndAnyTime>"              , false));
-	state                     = stoi(ParseSQLValue(strData, "<state>"                    ,     0));
-	iTimerType                = stoi(ParseSQLValue(strData, "<iTimerType>"               ,     0));
-	strTitle                  =      ParseSQLValue(strData, "<strTitle>"                 ,    "") ;
-	strEpgSearchString        =      ParseSQLValue(strData, "<strEpgSearchString>"       ,    "") ;
-	bFullTextEpgSearch        = stob(ParseSQLValue(strData, "<bFullTextEpgSearch>"       , false));
-	strDirectory              =      ParseSQLValue(strData, "<strDirectory>"             ,    "") ;
-	strSummary                =      ParseSQLValue(strData, "<strSummary>"               ,    "") ;
-	iPriority                 = stoi(ParseSQLValue(strData, "<iPriority>"                ,     0));
-	iLifetime                 = stoi(ParseSQLValue(strData, "<iLifetime>"                ,     0));
-	iMaxRecordings            = stoi(ParseSQLValue(strData, "<iMaxRecordings>"           ,     0));
-	iRecordingGroup           = stoi(ParseSQLValue(strData, "<iRecordingGroup>"          ,     0));
-	firstDay                  = stoi(ParseSQLValue(strData, "<firstDay>"                 ,     0));
-	iWeekdays                 = stoi(ParseSQLValue(strData, "<iWeekdays>"                ,     0));
-	iPreventDuplicateEpisodes = stoi(ParseSQLValue(strData, "<iPreventDuplicateEpisodes>",     0));
-	iEpgUid                   = stoi(ParseSQLValue(strData, "<iEpgUid>"                  ,     0));
-	iMarginStart              = stoi(ParseSQLValue(strData, "<iMarginStart>"             ,     0));
-	iMarginEnd                = stoi(ParseSQLValue(strData, "<iMarginEnd>"               ,     0));
-	iGenreType                = stoi(ParseSQLValue(strData, "<iGenreType>"               ,     0));
-	iGenreSubType             = stoi(ParseSQLValue(strData, "<iGenreSubType>"            ,     0));
-	strSeriesLink             =      ParseSQLValue(strData, "<strSeriesLink>"            ,    "") ;
+	iClientIndex              = sqlRow.GetInt   ("iClientIndex"             ,     0);
+	iParentClientIndex        = sqlRow.GetInt   ("iParentClientIndex"       ,     0);
+	iClientChannelUid         = sqlRow.GetInt   ("iClientChannelUid"        ,     0);
+	startTime                 = sqlRow.GetTime  ("startTime"                ,     0);
+	endTime                   = sqlRow.GetTime  ("endTime"                  ,     0);
+	bStartAnyTime             = sqlRow.GetBool  ("bStartAnyTime"            , false);
+	bEndAnyTime               = sqlRow.GetBool  ("bEndAnyTime"              , false);
+	state                     = sqlRow.GetInt   ("state"                    ,     0);
+	iTimerType                = sqlRow.GetInt   ("iTimerType"               ,     0);
+	strTitle                  = sqlRow.GetString("strTitle"                 ,    "");
+	strEpgSearchString        = sqlRow.GetString("strEpgSearchString"       ,    "");
+	bFullTextEpgSearch        = sqlRow.GetBool  ("bFullTextEpgSearch"       , false);
+	strDirectory              = sqlRow.GetString("strDirectory"             ,    "");
+	strSummary                = sqlRow.GetString("strSummary"               ,    "");
+	iPriority                 = sqlRow.GetInt   ("iPriority"                ,     0);
+	iLifetime                 = sqlRow.GetInt   ("iLifetime"                ,     0);
+	iMaxRecordings            = sqlRow.GetInt   ("iMaxRecordings"           ,     0);
+	iRecordingGroup           = sqlRow.GetInt   ("iRecordingGroup"          ,     0);
+	firstDay                  = sqlRow.GetInt   ("firstDay"                 ,     0);
+	iWeekdays                 = sqlRow.GetInt   ("iWeekdays"                ,     0);
+	iPreventDuplicateEpisodes = sqlRow.GetInt   ("iPreventDuplicateEpisodes",     0);
+	iEpgUid                   = sqlRow.GetInt   ("iEpgUid"                  ,     0);
+	iMarginStart              = sqlRow.GetInt   ("iMarginStart"             ,     0);
+	iMarginEnd                = sqlRow.GetInt   ("iMarginEnd"               ,     0);
+	iGenreType                = sqlRow.GetInt   ("iGenreType"               ,     0);
+	iGenreSubType             = sqlRow.GetInt   ("iGenreSubType"            ,     0);
+	strSeriesLink             = sqlRow.GetString("strSeriesLink"            ,    "");
 }
 
 DVRTimer::DVRTimer(void)
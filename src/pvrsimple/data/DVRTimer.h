@@ -23,6 +23,8 @@
  ***********************************************************/
 #include <kodi/xbmc_pvr_types.h>
 
+#include "SQLRow.h"
+
 #include "../utilities/SQLHelpers.h"
 #include "../utilities/Utilities.h"
 
@@ -38,9 +40,10 @@ class DVRTimer
 {
 	/* constructors/destrctors */
 	public:
-		 DVRTimer(string);
-		 DVRTimer(void  );
-		~DVRTimer(void  );
+		 DVRTimer(string       );
+		 DVRTimer(const SQLRow&);
+		 DVRTimer(void         );
+		~DVRTimer(void         );
 		
 	/* operator overloads */
 	public:
@@ -76,6 +79,10 @@ class DVRTimer
 		const int          GetGenreSubType            (void) {return iGenreSubType             ;}
 		const char*        GetSeriesLink              (void) {return strSeriesLink.c_str()     ;}
 		
+	/* set variable api calls */
+	public:
+		void               SetState                   (const int iState) {state = iState       ;}
+		
 	/* fetch structure api calls */
 	public:
 		PVR_TIMER Timer(void);
@@ -25,14 +25,19 @@
 /***********************************************************
  * Constructor/Destructor Definitions
  ***********************************************************/
-DVRTimerType::DVRTimerType(string strData)
+DVRTimerType::DVRTimerType(string strData) : DVRTimerType(SQLRow(strData))
+{
+	// decode record in one pass
+}
+
+DVRTimerType::DVRTimerType(const SQLRow& sqlRow)
 {
 	// assign data to structure
-	iId              = stoi(ParseSQLValue(strData, "<iId>"            ,  0));
-	iAttributes      = stoi(ParseSQLValue(strData, "<iAttributes>"    ,  0));
-	strDescription   =      ParseSQLValue(strData, "<strDescription>" , "") ;
-	iPrioritiesSize  = stoi(ParseSQLValue(strData, "<iPrioritiesSize>",  0));
-	iLifetimesSize   = stoi(ParseSQLValue(strData, "<iLifetimesSize>" ,  0));
+	iId              = sqlRow.GetInt   ("iId"            ,  0);
+	iAttributes      = sqlRow.GetInt   ("iAttributes"    ,  0);
+	strDescription   = sqlRow.GetString("strDescription" , "");
+	iPrioritiesSize  = sqlRow.GetInt   ("iPrioritiesSize",  0);
+	iLifetimesSize   = sqlRow.GetInt   ("iLifetimesSize" ,  0);
 }
 
 DVRTimerType::~DVRTimerType(void)
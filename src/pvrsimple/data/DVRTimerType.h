@@ -23,6 +23,8 @@
  ***********************************************************/
 #include <kodi/xbmc_pvr_types.h>
 
+#include "SQLRow.h"
+
 #include "../utilities/SQLHelpers.h"
 #include "../utilities/Utilities.h"
 
@@ -38,8 +40,9 @@ class DVRTimerType
 {
 	/* constructors/destrctors */
 	public:
-		 DVRTimerType(string);
-		~DVRTimerType(void  );
+		 DVRTimerType(string       );
+		 DVRTimerType(const SQLRow&);
+		~DVRTimerType(void         );
 		
 	/* fetch variable api calls */
 	public:
@@ -25,24 +25,29 @@
 /***********************************************************
  * Constructor/Destructor Definitions
  ***********************************************************/
-IPTVChannel::IPTVChannel(string strData)
+IPTVChannel::IPTVChannel(string strData) : IPTVChannel(SQLRow(strData))
+{
+	// decode record in one pass
+}
+
+IPTVChannel::IPTVChannel(const SQLRow& sqlRow)
 {
 	// assign data to structure
-	iUniqueId         = stoi(ParseSQLValue(strData, "<iUniqueId>"        ,     0));
-	bIsRadio          = stob(ParseSQLValue(strData, "<bIsRadio>"         , false));
-	iChannelNumber    = stoi(ParseSQLValue(strData, "<iChannelNumber>"   ,     0));
-	iSubChannelNumber = stoi(ParseSQLValue(strData, "<iSubChannelNumber>",     0));
-	strChannelName    =      ParseSQLValue(strData, "<strChannelName>"   ,    "") ;
-	strInputFormat    =      ParseSQLValue(strData, "<strInputFormat>"   ,    "") ;
-	iEncryptionSystem = stoi(ParseSQLValue(strData, "<iEncryptionSystem>",     0));
-	strIconPath       =      ParseSQLValue(strData, "<strIconPath>"      ,    "") ;
-	bIsHidden         = stob(ParseSQLValue(strData, "<bIsHidden>"        , false));
-	strGroupName      =      ParseSQLValue(strData, "<strGroupName>"     ,    "") ;
-	strStreamURL      =      ParseSQLValue(strData, "<strStreamURL>"     ,    "") ;
-	strTvgId          =      ParseSQLValue(strData, "<strTvgId>"         ,    "") ;
-	strTvgName        =      ParseSQLValue(strData, "<strTvgName>"       ,    "") ;
-	strTvgLogo        =      ParseSQLValue(strData, "<strTvgLogo>"       ,    "") ;
-	iTvgShift         = stof(ParseSQLValue(strData, "<iTvgShift>"        ,     0));
+	iUniqueId         = sqlRow.GetInt   ("iUniqueId"        ,     0);
+	bIsRadio          = sqlRow.GetBool  ("bIsRadio"         , false);
+	iChannelNumber    = sqlRow.GetInt   ("iChannelNumber"   ,     0);
+	iSubChannelNumber = sqlRow.GetInt   ("iSubChannelNumber",     0);
+	strChannelName    = sqlRow.GetString("strChannelName"   ,    "");
+	strInputFormat    = sqlRow.GetString("strInputFormat"   ,    "");
+	iEncryptionSystem = sqlRow.GetInt   ("iEncryptionSystem",     0);
+	strIconPath       = sqlRow.GetString("strIconPath"      ,    "");
+	bIsHidden         = sqlRow.GetBool  ("bIsHidden"        , false);
+	strGroupName      = sqlRow.GetString("strGroupName"     ,    "");
+	strStreamURL      = sqlRow.GetString("strStreamURL"     ,    "");
+	strTvgId          = sqlRow.GetString("strTvgId"         ,    "");
+	strTvgName        = sqlRow.GetString("strTvgName"       ,    "");
+	strTvgLogo        = sqlRow.GetString("strTvgLogo"       ,    "");
+	iTvgShift         = sqlRow.GetFloat ("iTvgShift"        ,     0);
 }
 
 IPTVChannel::~IPTVChannel(void)
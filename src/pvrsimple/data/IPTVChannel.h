@@ -23,6 +23,8 @@
  ***********************************************************/
 #include <kodi/xbmc_pvr_types.h>
 
+#include "SQLRow.h"
+
 #include "../utilities/SQLHelpers.h"
 #include "../utilities/Utilities.h"
 
@@ -38,8 +40,9 @@ class IPTVChannel
 {
 	/* constructors/destrctors */
 	public:
-		 IPTVChannel(string);
-		~IPTVChannel(void  );
+		 IPTVChannel(string       );
+		 IPTVChannel(const SQLRow&);
+		~IPTVChannel(void         );
 			
 	/* fetch variable api calls */
 	public:
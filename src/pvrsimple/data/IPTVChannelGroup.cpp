@@ -25,12 +25,17 @@
 /***********************************************************
  * Constructor/Destructor Definitions
  ***********************************************************/
-IPTVChannelGroup::IPTVChannelGroup(string strData)
+IPTVChannelGroup::IPTVChannelGroup(string strData) : IPTVChannelGroup(SQLRow(strData))
+{
+	// decode record in one pass
+}
+
+IPTVChannelGroup::IPTVChannelGroup(const SQLRow& sqlRow)
 {
 	// assign data to structure
-	strGroupName =      ParseSQLValue(strData, "<strGroupName>",    "") ;
-	bIsRadio     = stob(ParseSQLValue(strData, "<bIsRadio>"    , false));
-	iPosition    = stoi(ParseSQLValue(strData, "<iPosition>"   ,     0));
+	strGroupName = sqlRow.GetString("strGroupName",    "");
+	bIsRadio     = sqlRow.GetBool  ("bIsRadio"    , false);
+	iPosition    = sqlRow.GetInt   ("iPosition"   ,     0);
 }
 
 IPTVChannelGroup::~IPTVChannelGroup(void)
@@ -23,6 +23,8 @@
  ***********************************************************/
 #include <kodi/xbmc_pvr_types.h>
 
+#include "SQLRow.h"
+
 #include "../utilities/SQLHelpers.h"
 #include "../utilities/Utilities.h"
 
@@ -38,8 +40,9 @@ class IPTVChannelGroup
 {
 	/* constructors/destrctors */
 	public:
-		 IPTVChannelGroup(string);
-		~IPTVChannelGroup(void  );
+		 IPTVChannelGroup(string       );
+		 IPTVChannelGroup(const SQLRow&);
+		~IPTVChannelGroup(void         );
 			
 	/* fetch variable api calls */
 	public:
@@ -25,14 +25,19 @@
 /***********************************************************
  * Constructor/Destructor Definitions
  ***********************************************************/
-IPTVChannelGroupMember::IPTVChannelGroupMember(string strData)
+IPTVChannelGroupMember::IPTVChannelGroupMember(string strData) : IPTVChannelGroupMember(SQLRow(strData))
+{
+	// decode record in one pass
+}
+
+IPTVChannelGroupMember::IPTVChannelGroupMember(const SQLRow& sqlRow)
 {
 	// assign data to structure	
-	strGroupName      =      ParseSQLValue(strData, "<strGroupName>"     ,    "") ;
-	iChannelUniqueId  = stoi(ParseSQLValue(strData, "<iChannelUniqueId>" ,     0));
-	iChannelNumber    = stoi(ParseSQLValue(strData, "<iChannelNumber>"   ,     0));
-	iSubChannelNumber = stoi(ParseSQLValue(strData, "<iSubChannelNumber>",     0));
-	bIsRadio          = stob(ParseSQLValue(strData, "<bIsRadio>"         , false));
+	strGroupName      = sqlRow.GetString("strGroupName"     ,    "");
+	iChannelUniqueId  = sqlRow.GetInt   ("iChannelUniqueId" ,     0);
+	iChannelNumber    = sqlRow.GetInt   ("iChannelNumber"   ,     0);
+	iSubChannelNumber = sqlRow.GetInt   ("iSubChannelNumber",     0);
+	bIsRadio          = sqlRow.GetBool  ("bIsRadio"         , false);
 }
 
 IPTVChannelGroupMember::~IPTVChannelGroupMember(void)
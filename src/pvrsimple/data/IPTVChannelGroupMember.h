@@ -23,6 +23,8 @@
  ***********************************************************/
 #include <kodi/xbmc_pvr_types.h>
 
+#include "SQLRow.h"
+
 #include "../utilities/SQLHelpers.h"
 #include "../utilities/Utilities.h"
 
@@ -38,8 +40,9 @@ class IPTVChannelGroupMember
 {
 	/* constructors/destrctors */
 	public:
-		 IPTVChannelGroupMember(string);
-		~IPTVChannelGroupMember(void  );
+		 IPTVChannelGroupMember(string       );
+		 IPTVChannelGroupMember(const SQLRow&);
+		~IPTVChannelGroupMember(void         );
 		
 	/* fetch variable api calls */			
 	public:
@@ -25,12 +25,17 @@
 /***********************************************************
  * Constructor/Destructor Definitions
  ***********************************************************/
-IPTVEpgChannel::IPTVEpgChannel(string strData)
+IPTVEpgChannel::IPTVEpgChannel(string strData) : IPTVEpgChannel(SQLRow(strData))
+{
+	// decode record in one pass
+}
+
+IPTVEpgChannel::IPTVEpgChannel(const SQLRow& sqlRow)
 {
 	// assign data to structure
-	strTvgId   = ParseSQLValue(strData, "<strTvgId>"  , "");
-	strTvgName = ParseSQLValue(strData, "<strTvgName>", "");
-	strTvgLogo = ParseSQLValue(strData, "<strTvgLogo>", "");
+	strTvgId   = sqlRow.GetString("strTvgId"  , "");
+	strTvgName = sqlRow.GetString("strTvgName", "");
+	strTvgLogo = sqlRow.GetString("strTvgLogo", "");
 }
 
 IPTVEpgChannel::~IPTVEpgChannel(void)
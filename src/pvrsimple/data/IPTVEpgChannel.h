@@ -23,6 +23,8 @@
  ***********************************************************/
 #include <kodi/xbmc_pvr_types.h>
 
+#include "SQLRow.h"
+
 #include "../utilities/SQLHelpers.h"
 #include "../utilities/Utilities.h"
 
@@ -38,8 +40,9 @@ class IPTVEpgChannel
 {
 	/* constructors/destrctors */
 	public:
-		 IPTVEpgChannel(string);
-		~IPTVEpgChannel(void  );
+		 IPTVEpgChannel(string       );
+		 IPTVEpgChannel(const SQLRow&);
+		~IPTVEpgChannel(void         );
 			
 	/* fetch variable api calls */
 	public:
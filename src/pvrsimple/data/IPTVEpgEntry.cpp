@@ -25,37 +25,42 @@
 /***********************************************************
  * Constructor/Destructor Definitions
  ***********************************************************/
-IPTVEpgEntry::IPTVEpgEntry(string strData)
+IPTVEpgEntry::IPTVEpgEntry(string strData) : IPTVEpgEntry(SQLRow(strData))
+{
+	// decode record in one pass
+}
+
+IPTVEpgEntry::IPTVEpgEntry(const SQLRow& sqlRow)
 {
 	// assign data to structure
-	iUniqueBroadcastId  = stoi(ParseSQLValue(strData, "<iUniqueBroadcastId>" ,     0));
-	iUniqueChannelId    = stoi(ParseSQLValue(strData, "<iUniqueChannelId>"   ,     0)); 
-	strTitle            =      ParseSQLValue(strData, "<strTitle>"           ,    "") ;
-	startTime           = stoi(ParseSQLValue(strData, "<startTime>"          ,     0));
-	endTime             = stoi(ParseSQLValue(strData, "<endTime>"            ,     0));
-	strPlotOutline      =      ParseSQLValue(strData, "<strPlotOutline>"     ,    "") ;
-	strPlot             =      ParseSQLValue(strData, "<strPlot>"            ,    "") ;
-	strOriginalTitle    =      ParseSQLValue(strData, "<strOriginalTitle>"   ,    "") ;
-	strCast             =      ParseSQLValue(strData, "<strCast>"            ,    "") ;
-	strDirector         =      ParseSQLValue(strData, "<strDirector>"        ,    "") ;
-	strWriter           =      ParseSQLValue(strData, "<strWriter>"          ,    "") ;
-	iYear               = stoi(ParseSQLValue(strData, "<iYear>"              ,     0));
-	strIMDBNumber       =      ParseSQLValue(strData, "<strIMDBNumber>"      ,    "") ;
-	strIconPath         =      ParseSQLValue(strData, "<strIconPath>"        ,    "") ;
-	iGenreType          = stoi(ParseSQLValue(strData, "<iGenreType>"         ,     0));
-	iGenreSubType       = stoi(ParseSQLValue(strData, "<iGenreSubType>"      ,     0));
-	strGenreDescription =      ParseSQLValue(strData, "<strGenreDescription>",    "") ;
-	firstAired          = stoi(ParseSQLValue(strData, "<firstAired>"         ,     0));
-	iParentalRating     = stoi(ParseSQLValue(strData, "<iParentalRating>"    ,     0));
-	iStarRating         = stoi(ParseSQLValue(strData, "<iStarRating>"        ,     0));
-	bNotify             = stob(ParseSQLValue(strData, "<bNotify>"            , false));
-	iSeriesNumber       = stoi(ParseSQLValue(strData, "<iSeriesNumber>"      ,     0));
-	iEpisodeNumber      = stoi(ParseSQLValue(strData, "<iEpisodeNumber>"     ,     0));
-	iEpisodePartNumber  = stoi(ParseSQLValue(strData, "<iEpisodePartNumber>" ,     0));
-	strEpisodeName      =      ParseSQLValue(strData, "<strEpisodeName>"     ,    "") ;
-	iFlags              = stoi(ParseSQLValue(strData, "<iFlags>"             ,     0));
-	strSeriesLink       =      ParseSQLValue(strData, "<strSeriesLink>"      ,    "") ;
-	strTvgId            =      ParseSQLValue(strData, "<strTvgId>"           ,    "") ;
+	iUniqueBroadcastId  = sqlRow.GetInt   ("iUniqueBroadcastId" ,     0);
+	iUniqueChannelId    = sqlRow.GetInt   ("iUniqueChannelId"   ,     0); 
+	strTitle            = sqlRow.GetString("strTitle"           ,    "");
+	startTime           = sqlRow.GetTime  ("startTime"          ,     0);
+	endTime             = sqlRow.GetTime  ("endTime"            ,     0);
+	strPlotOutline      = sqlRow.GetString("strPlotOutline"     ,    "");
+	strPlot             = sqlRow.GetString("strPlot"            ,    "");
+	strOriginalTitle    = sqlRow.GetString("strOriginalTitle"   ,    "");
+	strCast             = sqlRow.GetString("strCast"            ,    "");
+	strDirector         = sqlRow.GetString("strDirector"        ,    "");
+	strWriter           = sqlRow.GetString("strWriter"          ,    "");
+	iYear               = sqlRow.GetInt   ("iYear"              ,     0);
+	strIMDBNumber       = sqlRow.GetString("strIMDBNumber"      ,    "");
+	strIconPath         = sqlRow.GetString("strIconPath"        ,    "");
+	iGenreType          = sqlRow.GetInt   ("iGenreType"         ,     0);
+	iGenreSubType       = sqlRow.GetInt   ("iGenreSubType"      ,     0);
+	strGenreDescription = sqlRow.GetString("strGenreDescription",    "");
+	firstAired          = sqlRow.GetTime  ("firstAired"         ,     0);
+	iParentalRating     = sqlRow.GetInt   ("iParentalRating"    ,     0);
+	iStarRating         = sqlRow.GetInt   ("iStarRating"        ,     0);
+	bNotify             = sqlRow.GetBool  ("bNotify"            , false);
+	iSeriesNumber       = sqlRow.GetInt   ("iSeriesNumber"      ,     0);
+	iEpisodeNumber      = sqlRow.GetInt   ("iEpisodeNumber"     ,     0);
+	iEpisodePartNumber  = sqlRow.GetInt   ("iEpisodePartNumber" ,     0);
+	strEpisodeName      = sqlRow.GetString("strEpisodeName"     ,    "");
+	iFlags              = sqlRow.GetInt   ("iFlags"             ,     0);
+	strSeriesLink       = sqlRow.GetString("strSeriesLink"      ,    "");
+	strTvgId            = sqlRow.GetString("strTvgId"           ,    "");
 }
 
 IPTVEpgEntry::~IPTVEpgEntry(void)
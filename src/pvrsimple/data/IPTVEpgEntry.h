@@ -23,6 +23,8 @@
  ***********************************************************/
 #include <kodi/xbmc_pvr_types.h>
 
+#include "SQLRow.h"
+
 #include "../utilities/SQLHelpers.h"
 #include "../utilities/Utilities.h"
 
@@ -38,8 +40,9 @@ class IPTVEpgEntry
 {
 	/* constructors/destrctors */
 	public:
-		 IPTVEpgEntry(string);
-		~IPTVEpgEntry(void  );
+		 IPTVEpgEntry(string       );
+		 IPTVEpgEntry(const SQLRow&);
+		~IPTVEpgEntry(void         );
 		
 	/* fetch variable api calls */
 	public:
@@ -0,0 +1,239 @@
+﻿/*
+ *  pvr.sql - A PVR client for Kodi using M3U, XMLTV, and FFMPEG
+ *  Copyright © 2018 El_Gonz87 (Gonzalo Vega)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/***********************************************************
+ * Headers
+ ***********************************************************/
+#include "SQLCursor.h"
+
+/***********************************************************
+ * Constructor/Destructor Definitions
+ ***********************************************************/
+SQLCursor::SQLCursor(void) : sqlRow(string(""))
+{
+	// nothing open at start
+	sqlStatement = NULL ;
+	pLock        = NULL ;
+	tcpClient    = NULL ;
+	iBufferPos   = 0    ;
+	bEndOfData   = true ;
+	iStatus      = 0    ;
+}
+
+SQLCursor::~SQLCursor(void)
+{
+	// release lock or connection
+	Close();
+}
+
+/***********************************************************
+ * Open/Close Definitions
+ ***********************************************************/
+void SQLCursor::Open(sqlite3_stmt* sqlQuery, mutex* pMutex)
+{
+	// release previous source
+	Close();
+	
+	// step rows straight from statement (lock already held by caller)
+	sqlStatement = sqlQuery                           ;
+	pLock        = pMutex                             ;
+	bEndOfData   = !sqlQuery                          ;
+	iStatus      = sqlQuery ? SQLITE_OK : SQLITE_ERROR ;
+	
+	// create row view over statement
+	if (sqlQuery)
+		sqlRow = SQLRow(sqlQuery);
+}
+
+void SQLCursor::Open(tcp_client_t* tcpConnection)
+{
+	// release previous source
+	Close();
+	
+	// read rows from response body (headers already parsed by caller)
+	tcpClient  = tcpConnection                            ;
+	bEndOfData = !tcpConnection                           ;
+	iStatus    = tcpConnection ? SQLITE_OK : SQLITE_ERROR ;
+	
+	// clear buffer
+	strBuffer.clear();
+	iBufferPos = 0;
+}
+
+void SQLCursor::Buffer(void)
+{
+	// nothing to buffer unless stepping a statement
+	if (!sqlStatement)
+		return;
+	
+	// create local containers
+	string strRows  ;
+	int    iResponse;
+	
+	// read remaining rows as lines (same text the server streams)
+	while ((iResponse = sqlite3_step(sqlStatement)) == SQLITE_ROW)
+		strRows += sqlRow.GetRecord() + "\n";
+	
+	// keep failure for caller (done is ok)
+	iStatus = (iResponse == SQLITE_DONE) ? SQLITE_OK : iResponse;
+	
+	// release statement and lock now rather than after last row
+	Close();
+	
+	// read rows from buffer from here on
+	strBuffer.swap(strRows);
+	bEndOfData = strBuffer.empty();
+}
+
+void SQLCursor::Close(void)
+{
+	// rewind statement so it does not hold the database
+	if (sqlStatement)
+		sqlite3_reset(sqlStatement);
+	
+	// release reader or writer
+	if (pLock)
+		pLock->unlock();
+	
+	// close connection
+	if (tcpClient)
+	{
+		tcpClient->close();
+		delete tcpClient;
+	}
+	
+	// clear source
+	sqlStatement = NULL;
+	pLock        = NULL;
+	tcpClient    = NULL;
+	bEndOfData   = true;
+	
+	// drop buffered text
+	strBuffer.clear();
+	strRecord.clear();
+	iBufferPos = 0;
+}
+
+/***********************************************************
+ * Fetch Row Definitions
+ ***********************************************************/
+bool SQLCursor::Next(void)
+{
+	// nothing left to read
+	if (bEndOfData)
+		return false;
+	
+	// step statement
+	if (sqlStatement)
+	{
+		// create local containers
+		int iResponse = sqlite3_step(sqlStatement);
+		
+		// row is ready in view
+		if (iResponse == SQLITE_ROW)
+			return true;
+		
+		// keep failure for caller (done is ok)
+		iStatus = (iResponse == SQLITE_DONE) ? SQLITE_OK : iResponse;
+		
+		// release as soon as done
+		Close();
+		
+		// return end
+		return false;
+	}
+	
+	// read next line from connection (skip empty lines)
+	while (ReadLine())
+	{
+		if (strRecord.size())
+		{
+			// parse line into row
+			sqlRow = SQLRow(strRecord);
+			
+			// return row
+			return true;
+		}
+	}
+	
+	// release as soon as done
+	Close();
+	
+	// return end
+	return false;
+}
+
+const SQLRow& SQLCursor::GetRow(void) const
+{
+	// return current row
+	return sqlRow;
+}
+
+int SQLCursor::GetStatus(void) const
+{
+	// return sqlite status of last step
+	return iStatus;
+}
+
+/***********************************************************
+ * Stream Definitions
+ ***********************************************************/
+bool SQLCursor::ReadLine(void)
+{
+	// fill buffer until a full line is present
+	while (true)
+	{
+		// look for end of line in buffer
+		size_t iLineEnd = strBuffer.find('\n', iBufferPos);
+		
+		// return line if found
+		if (iLineEnd != string::npos)
+		{
+			strRecord  = strBuffer.substr(iBufferPos, iLineEnd - iBufferPos);
+			iBufferPos = iLineEnd + 1;
+			return true;
+		}
+		
+		// return remainder once connection closed
+		if (!tcpClient)
+		{
+			strRecord  = strBuffer.substr(iBufferPos);
+			iBufferPos = strBuffer.size();
+			return strRecord.size() > 0;
+		}
+		
+		// drop lines already read (keeps buffer to one block plus a partial line)
+		strBuffer.erase(0, iBufferPos);
+		iBufferPos = 0;
+		
+		// read next block
+		size_t iSize  = strBuffer.size();
+		strBuffer.resize(iSize + SERVER_BUFFER_SIZE);
+		int    iBytes = tcpClient->read_all(&strBuffer[iSize], SERVER_BUFFER_SIZE);
+		strBuffer.resize(iSize + (iBytes > 0 ? iBytes : 0));
+		
+		// short read means server closed connection
+		if (iBytes < SERVER_BUFFER_SIZE)
+		{
+			tcpClient->close();
+			delete tcpClient;
+			tcpClient = NULL;
+		}
+	}
+}
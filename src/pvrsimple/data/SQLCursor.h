@@ -0,0 +1,84 @@
+#pragma once
+/*
+ *  pvr.sql - A PVR client for Kodi using M3U, XMLTV, and FFMPEG
+ *  Copyright © 2018 El_Gonz87 (Gonzalo Vega)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/***********************************************************
+ * Headers
+ ***********************************************************/
+#include <mutex>
+
+#include "sqlite/sqlite3.h"
+#include "netsockets/socket.hh"
+
+#include "SQLRow.h"
+#include "../PVRTypes.h"
+#include "../utilities/Utilities.h"
+
+/***********************************************************
+ * Namespace Definitions
+ ***********************************************************/
+using namespace std;
+
+/***********************************************************
+ * Class Definitions
+ ***********************************************************/
+class SQLCursor
+{
+	/* constructors/destrctors */
+	public:
+		 SQLCursor(void);
+		~SQLCursor(void);
+		
+	/* no copies (cursor owns a lock or a socket) */
+	private:
+		           SQLCursor(const SQLCursor&);
+		SQLCursor& operator=(const SQLCursor&);
+		
+	/* open/close api calls (source holds lock or connection until close, buffer reads rest and releases lock) */
+	public:
+		void Open  (sqlite3_stmt*, mutex*);
+		void Open  (tcp_client_t*        );
+		void Buffer(void                 );
+		void Close (void                 );
+		
+	/* forward only fetch api calls */
+	public:
+		bool          Next     (void      );
+		const SQLRow& GetRow   (void) const;
+		int           GetStatus(void) const;
+		
+	/* stream functions */
+	private:
+		bool ReadLine(void);
+		
+	/* source variables */
+	private:
+		sqlite3_stmt *sqlStatement;
+		mutex        *pLock       ;
+		tcp_client_t *tcpClient   ;
+		
+	/* row variables */
+	private:
+		string strBuffer ;
+		size_t iBufferPos;
+		bool   bEndOfData;
+		int    iStatus   ;
+		string strRecord ;
+		SQLRow sqlRow    ;
+};
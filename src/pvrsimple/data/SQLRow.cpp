@@ -0,0 +1,215 @@
+﻿/*
+ *  pvr.sql - A PVR client for Kodi using M3U, XMLTV, and FFMPEG
+ *  Copyright © 2018 El_Gonz87 (Gonzalo Vega)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/***********************************************************
+ * Headers
+ ***********************************************************/
+#include "SQLRow.h"
+
+/***********************************************************
+ * Constructor/Destructor Definitions
+ ***********************************************************/
+SQLRow::SQLRow(sqlite3_stmt* sqlQuery)
+{
+	// read columns straight from stepped statement
+	sqlStatement = sqlQuery                       ;
+	iColumns     = sqlite3_column_count(sqlQuery) ;
+	iLastColumn  = -1                             ;
+}
+
+SQLRow::SQLRow(const string& strData)
+{
+	// no statement for records sent over tcp
+	sqlStatement = NULL;
+	iLastColumn  = -1  ;
+	
+	// create position containers
+	size_t iNameStart  = 0;
+	size_t iNameEnd    = 0;
+	size_t iValueEnd   = 0;
+	
+	// parse <name>value</name> pairs in one pass (values never contain '<')
+	while ((iNameStart = strData.find('<', iValueEnd)) != string::npos)
+	{
+		// find end of open marker
+		if ((iNameEnd = strData.find('>', iNameStart)) == string::npos)
+			break;
+			
+		// find start of close marker
+		if ((iValueEnd = strData.find('<', iNameEnd)) == string::npos)
+			break;
+		
+		// add column
+		strColumns.push_back(                 strData.substr(iNameStart + 1, iNameEnd  - iNameStart - 1) );
+		strValues.push_back (UnescapeSQLValue(strData.substr(iNameEnd   + 1, iValueEnd - iNameEnd   - 1)));
+		
+		// skip close marker
+		if ((iValueEnd = strData.find('>', iValueEnd)) == string::npos)
+			break;
+	}
+	
+	// set number of columns
+	iColumns = (int)strColumns.size();
+}
+
+SQLRow::~SQLRow(void)
+{
+	// no need to destruct (statement owned by connection)
+}
+
+/***********************************************************
+ * Fetch Column Definitions
+ ***********************************************************/
+int SQLRow::GetInt(const char* strColumn, const int iDefault /* = 0 */) const
+{
+	// look for column
+	int i = FindColumn(strColumn);
+	
+	// return default if missing or null
+	if (i < 0 || (sqlStatement && sqlite3_column_type(sqlStatement, i) == SQLITE_NULL))
+		return iDefault;
+	
+	// return value
+	return sqlStatement ? sqlite3_column_int(sqlStatement, i) : atoi(strValues[i].c_str());
+}
+
+long long SQLRow::GetInt64(const char* strColumn, const long long iDefault /* = 0 */) const
+{
+	// look for column
+	int i = FindColumn(strColumn);
+	
+	// return default if missing or null
+	if (i < 0 || (sqlStatement && sqlite3_column_type(sqlStatement, i) == SQLITE_NULL))
+		return iDefault;
+	
+	// return value
+	return sqlStatement ? sqlite3_column_int64(sqlStatement, i) : atoll(strValues[i].c_str());
+}
+
+time_t SQLRow::GetTime(const char* strColumn, const time_t iDefault /* = 0 */) const
+{
+	// look for column
+	int i = FindColumn(strColumn);
+	
+	// return default if missing or null
+	if (i < 0 || (sqlStatement && sqlite3_column_type(sqlStatement, i) == SQLITE_NULL))
+		return iDefault;
+	
+	// return value
+	return sqlStatement ? (time_t)sqlite3_column_int64(sqlStatement, i) : (time_t)atoll(strValues[i].c_str());
+}
+
+float SQLRow::GetFloat(const char* strColumn, const float fDefault /* = 0 */) const
+{
+	// look for column
+	int i = FindColumn(strColumn);
+	
+	// return default if missing or null
+	if (i < 0 || (sqlStatement && sqlite3_column_type(sqlStatement, i) == SQLITE_NULL))
+		return fDefault;
+	
+	// return value
+	return sqlStatement ? (float)sqlite3_column_double(sqlStatement, i) : (float)atof(strValues[i].c_str());
+}
+
+bool SQLRow::GetBool(const char* strColumn, const bool bDefault /* = false */) const
+{
+	// look for column
+	int i = FindColumn(strColumn);
+	
+	// return default if missing or null
+	if (i < 0 || (sqlStatement && sqlite3_column_type(sqlStatement, i) == SQLITE_NULL))
+		return bDefault;
+	
+	// booleans are stored as text
+	const char* strValue = sqlStatement ? (const char*)sqlite3_column_text(sqlStatement, i) : strValues[i].c_str();
+	
+	// return value
+	return (strcmp(strValue, "true") == 0 || strcmp(strValue, "1") == 0);
+}
+
+string SQLRow::GetString(const char* strColumn, const char* strDefault /* = "" */) const
+{
+	// look for column
+	int i = FindColumn(strColumn);
+	
+	// return default if missing
+	if (i < 0)
+		return string(strDefault);
+	
+	// read from statement
+	if (sqlStatement)
+	{
+		// get text and size (null is empty text)
+		const char* strValue = (const char*)sqlite3_column_text (sqlStatement, i);
+		int         iSize    =              sqlite3_column_bytes(sqlStatement, i);
+		
+		// return value
+		return strValue ? string(strValue, iSize) : string();
+	}
+	
+	// return value
+	return strValues[i];
+}
+
+/***********************************************************
+ * Encode Definitions
+ ***********************************************************/
+string SQLRow::GetRecord(void) const
+{
+	// create container for string
+	string strRecord;
+	
+	// write <name>value</name> pairs in column order
+	for (int i = 0; i < iColumns; i++)
+	{
+		// get column name and value
+		const char* strName  = sqlStatement ?              sqlite3_column_name(sqlStatement, i) : strColumns[i].c_str();
+		const char* strValue = sqlStatement ? (const char*)sqlite3_column_text(sqlStatement, i) : strValues[i].c_str() ;
+		
+		// append to record
+		strRecord += string("<") + string(strName) + string(">") + EscapeSQLValue(strValue ? strValue : "") + string("</") + string(strName) + string(">");
+	}
+	
+	// return record
+	return strRecord;
+}
+
+/***********************************************************
+ * Column Lookup Definitions
+ ***********************************************************/
+int SQLRow::FindColumn(const char* strColumn) const
+{
+	// columns are usually read in table order so start after last hit
+	for (int n = 1; n <= iColumns; n++)
+	{
+		// wrap around column index
+		int i = (iLastColumn + n) % iColumns;
+		
+		// get column name
+		const char* strName = sqlStatement ? sqlite3_column_name(sqlStatement, i) : strColumns[i].c_str();
+		
+		// return index if found
+		if (strcmp(strName, strColumn) == 0)
+			return (iLastColumn = i);
+	}
+	
+	// return not found
+	return -1;
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+/*
+ *  pvr.sql - A PVR client for Kodi using M3U, XMLTV, and FFMPEG
+ *  Copyright © 2018 El_Gonz87 (Gonzalo Vega)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/***********************************************************
+ * Headers
+ ***********************************************************/
+#include "sqlite/sqlite3.h"
+
+#include "../utilities/SQLHelpers.h"
+#include "../utilities/Utilities.h"
+
+/***********************************************************
+ * Namespace Definitions
+ ***********************************************************/
+using namespace std;
+
+/***********************************************************
+ * Class Definitions
+ ***********************************************************/
+class SQLRow
+{
+	/* constructors/destrctors */
+	public:
+		 SQLRow(sqlite3_stmt* );
+		 SQLRow(const string&);
+		~SQLRow(void         );
+			
+	/* fetch column api calls */
+	public:
+		int       GetInt   (const char*, const int       =     0) const;
+		long long GetInt64 (const char*, const long long =     0) const;
+		time_t    GetTime  (const char*, const time_t    =     0) const;
+		float     GetFloat (const char*, const float     =     0) const;
+		bool      GetBool  (const char*, const bool      = false) const;
+		string    GetString(const char*, const char*     =    "") const;
+		
+	/* encode api calls */
+	public:
+		string GetRecord(void) const;
+		
+	/* column lookup */
+	private:
+		int FindColumn(const char*) const;
+		
+	/* internal variables */
+	private:
+		sqlite3_stmt*  sqlStatement;
+		int            iColumns    ;
+		vector<string> strColumns  ;
+		vector<string> strValues   ;
+		mutable int    iLastColumn ;
+};
\ No newline at end of file
@@ -20,76 +20,249 @@
 /***********************************************************
  * Headers
  ***********************************************************/
+#include "Callbacks.h"
 #include "GZHelpers.h"
 
 /***********************************************************
- * Decompress Function Definitions
+ * Constructor/Destructor Definitions
  ***********************************************************/
-bool GzipInflate(const string& compressedBytes, string& uncompressedBytes) 
+GzipReader::GzipReader(void)
 {
-	/*
-	 * This method uses zlib to decompress a gzipped file in memory.
-	 * Author: Andrew Lim Chong Liang
-	 * http://windrealm.org
-	 */
-	#define HANDLE_CALL_ZLIB(status) {if(status != Z_OK) {free(uncomp); return false;}}
+	// nothing open at start
+	fileHandle    = NULL ;
+	bIsCompressed = false;
+	bEndOfFile    = true ;
+	iStatus       = Z_OK ;
+	iBufferPos    = 0    ;
+	
+	// clear inflate state
+	memset(&zStream, 0, sizeof(z_stream));
+}
+
+GzipReader::~GzipReader(void)
+{
+	// release file and inflate state
+	Close();
+}
 
-	if (compressedBytes.size() == 0)
+/***********************************************************
+ * Open/Close Definitions
+ ***********************************************************/
+bool GzipReader::Open(const char* strPath)
+{
+	// release previous file
+	Close();
+	
+	// open the file via kodi
+	fileHandle = XBMC->OpenFile(strPath, 0);
+	
+	// return error if not found
+	if (!fileHandle)
+		return false;
+	
+	// create input chunk
+	strInput.resize(GZIP_READ_SIZE);
+	bEndOfFile = false;
+	
+	// read first chunk to look for archive header
+	ReadInput();
+	
+	// check if a compressed archive
+	bIsCompressed = (zStream.avail_in >= 3 && memcmp(zStream.next_in, GZIP_MARKER, 3) == 0);
+	
+	// start inflate with gzip header detection
+	if (bIsCompressed)
+		iStatus = inflateInit2(&zStream, (16+MAX_WBITS));
+	
+	// log failure
+	if (iStatus != Z_OK)
 	{
-		uncompressedBytes = compressedBytes;
-		return true;
+		XBMC->Log(LOG_ERROR, "C+: %s - Invalid file unable to decompress file (%s)", __FUNCTION__, strPath);
+		Close();
+		return false;
 	}
+	
+	// return status
+	return true;
+}
 
-	uncompressedBytes.clear() ;
-
-	unsigned full_length = compressedBytes.size() ;
-	unsigned half_length = compressedBytes.size() / 2;
-
-	unsigned uncompLength = full_length ;
-	char* uncomp = (char*) calloc(sizeof(char), uncompLength);
-
-	z_stream strm;
-	strm.next_in = (Bytef *) compressedBytes.c_str();
-	strm.avail_in = compressedBytes.size() ;
-	strm.total_out = 0;
-	strm.zalloc = Z_NULL;
-	strm.zfree = Z_NULL;
-
-	bool done = false ;
-
-	HANDLE_CALL_ZLIB(inflateInit2(&strm, (16+MAX_WBITS)));
+void GzipReader::Close(void)
+{
+	// release inflate state
+	if (bIsCompressed)
+		inflateEnd(&zStream);
+	
+	// close file
+	if (fileHandle)
+		XBMC->CloseFile(fileHandle);
+	
+	// clear source
+	fileHandle    = NULL ;
+	bIsCompressed = false;
+	bEndOfFile    = true ;
+	
+	// clear inflate state
+	memset(&zStream, 0, sizeof(z_stream));
+	
+	// drop buffered data
+	strInput.clear();
+	strBuffer.clear();
+	strBlock.clear();
+	iBufferPos = 0;
+}
 
-	while (!done)
+/***********************************************************
+ * Read Definitions
+ ***********************************************************/
+int GzipReader::Read(char* buffer, const int iSize)
+{
+	// nothing open
+	if (!fileHandle || iStatus != Z_OK)
+		return 0;
+	
+	// hand out buffered input first, then read straight into caller buffer
+	if (!bIsCompressed)
 	{
-		// If our output buffer is too small
-		if (strm.total_out >= uncompLength)
+		// copy left over input
+		if (zStream.avail_in)
 		{
-			// Increase size of output buffer
-			uncomp = (char *) realloc(uncomp, uncompLength + half_length);
-			if (uncomp == NULL)
-				return false;
-			uncompLength += half_length;
+			int iBytes = (int)zStream.avail_in < iSize ? (int)zStream.avail_in : iSize;
+			
+			memcpy(buffer, zStream.next_in, iBytes);
+			
+			zStream.next_in  += iBytes;
+			zStream.avail_in -= iBytes;
+			
+			return iBytes;
 		}
-
-		strm.next_out = (Bytef *) (uncomp + strm.total_out);
-		strm.avail_out = uncompLength - strm.total_out;
-
-		// Inflate another chunk.
-		int err = inflate (&strm, Z_SYNC_FLUSH);
 		
-		if (err == Z_STREAM_END)
-			done = true;
-		else if (err != Z_OK)
+		// read from file
+		int iBytes = bEndOfFile ? 0 : (int)XBMC->ReadFile(fileHandle, buffer, iSize);
+		
+		// mark end of file
+		if (iBytes <= 0)
+		{
+			bEndOfFile = true;
+			return 0;
+		}
+		
+		// return size read
+		return iBytes;
+	}
+	
+	// inflate into caller buffer
+	zStream.next_out  = (Bytef*)buffer;
+	zStream.avail_out = iSize;
+	
+	// fill until buffer is full or archive ends
+	while (zStream.avail_out)
+	{
+		// read next chunk if input used up
+		if (!zStream.avail_in && !ReadInput())
+		{
+			// archive cut short
+			iStatus = Z_DATA_ERROR;
 			break;
+		}
+		
+		// inflate another chunk
+		int iResponse = inflate(&zStream, Z_NO_FLUSH);
+		
+		// start next member if archive holds several (concatenated gzip)
+		if (iResponse == Z_STREAM_END)
+		{
+			// done if nothing follows
+			if (!zStream.avail_in && !ReadInput())
+			{
+				bEndOfFile = true;
+				iStatus    = Z_STREAM_END;
+				break;
+			}
+			
+			// reset for next member
+			iResponse = inflateReset(&zStream);
+		}
+		
+		// keep failure for caller
+		if (iResponse != Z_OK)
+		{
+			iStatus = iResponse;
+			break;
+		}
 	}
+	
+	// return size inflated
+	return iSize - zStream.avail_out;
+}
 
-	HANDLE_CALL_ZLIB(inflateEnd(&strm));
-
-	for ( size_t i=0; i<strm.total_out; ++i)
+bool GzipReader::ReadLine(string& strLine)
+{
+	// fill buffer until a full line is present
+	while (true)
 	{
-		uncompressedBytes += uncomp[i];
+		// look for end of line in buffer
+		size_t iLineEnd = strBuffer.find('\n', iBufferPos);
+		
+		// return line if found
+		if (iLineEnd != string::npos)
+		{
+			strLine.assign(strBuffer, iBufferPos, iLineEnd - iBufferPos);
+			iBufferPos = iLineEnd + 1;
+			return true;
+		}
+		
+		// drop lines already read (keeps buffer to one chunk plus a partial line)
+		strBuffer.erase(0, iBufferPos);
+		iBufferPos = 0;
+		
+		// create read block
+		strBlock.resize(GZIP_READ_SIZE);
+		
+		// read next block
+		int iBytes = Read(&strBlock[0], GZIP_READ_SIZE);
+		
+		// return remainder once file ends
+		if (iBytes <= 0)
+		{
+			strLine.assign(strBuffer);
+			iBufferPos = strBuffer.size();
+			return strLine.size() > 0;
+		}
+		
+		// add block to buffer
+		strBuffer.append(&strBlock[0], iBytes);
 	}
+}
+
+int GzipReader::GetStatus(void) const
+{
+	// return zlib status (stream end is a clean finish)
+	return (iStatus == Z_STREAM_END) ? Z_OK : iStatus;
+}
 
-	free(uncomp);
+/***********************************************************
+ * Stream Definitions
+ ***********************************************************/
+bool GzipReader::ReadInput(void)
+{
+	// nothing left to read
+	if (bEndOfFile)
+		return false;
+	
+	// read next chunk
+	int iBytes = (int)XBMC->ReadFile(fileHandle, &strInput[0], GZIP_READ_SIZE);
+	
+	// mark end of file
+	if (iBytes <= 0)
+	{
+		bEndOfFile = true;
+		return false;
+	}
+	
+	// point inflate at chunk
+	zStream.next_in  = (Bytef*)&strInput[0];
+	zStream.avail_in = iBytes;
+	
+	// return status
 	return true;
 }
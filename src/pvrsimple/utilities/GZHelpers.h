@@ -29,6 +29,53 @@
 using namespace std;
 
 /***********************************************************
- * Decompress Function Definitions
+ * Define Constants
  ***********************************************************/
-bool GzipInflate(const string&, string&);
\ No newline at end of file
+#define GZIP_READ_SIZE 65536
+#define GZIP_MARKER    "\x1F\x8B\x08"
+
+/***********************************************************
+ * Class Definitions
+ ***********************************************************/
+class GzipReader
+{
+	/* constructors/destrctors */
+	public:
+		 GzipReader(void);
+		~GzipReader(void);
+		
+	/* no copies (reader owns a file handle and inflate state) */
+	private:
+		            GzipReader(const GzipReader&);
+		GzipReader& operator=(const GzipReader&);
+		
+	/* open/close api calls (archives detected by header) */
+	public:
+		bool Open (const char*);
+		void Close(void       );
+		
+	/* forward only read api calls (plain files pass through, archives inflate chunk by chunk) */
+	public:
+		int  Read     (char*, const int);
+		bool ReadLine (string&         );
+		int  GetStatus(void            ) const;
+		
+	/* stream functions */
+	private:
+		bool ReadInput(void);
+		
+	/* source variables */
+	private:
+		void     *fileHandle   ;
+		z_stream  zStream      ;
+		bool      bIsCompressed;
+		bool      bEndOfFile   ;
+		int       iStatus      ;
+		string    strInput     ;
+		
+	/* line variables */
+	private:
+		string strBuffer ;
+		size_t iBufferPos;
+		string strBlock  ;
+};
\ No newline at end of file
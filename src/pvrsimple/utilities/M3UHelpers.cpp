@@ -25,65 +25,108 @@
 /***********************************************************
  * Parse Function Definitions
  ***********************************************************/
-string ReadM3UMarkerValue(const string& strLine, const char* strMarker, const char* strDefault /*= ""*/)
+bool ParseM3UInfo(const string& strLine, M3UInfo& m3uInfo)
 {
-	// get start of marker in line
-	int iMarkerStart = (int)strLine.find(strMarker);
-	int iMarkerEnd                                 ;
-
-	// parse through line for value
-	if (iMarkerStart >= 0)
+	// clear values (absent attributes point nowhere)
+	m3uInfo = M3UInfo();
+	
+	// check if info line
+	if (strLine.compare(0, strlen(M3U_INFO_MARKER), M3U_INFO_MARKER) != 0)
+		return false;
+	
+	// point to line after marker (values point into line, nothing copied)
+	const char* pChr = strLine.c_str() + strlen(M3U_INFO_MARKER);
+	const char* pEnd = strLine.c_str() + strLine.length()      ;
+	
+	// skip duration
+	if (pChr < pEnd && *pChr == ':')
+		pChr++;
+	
+	while (pChr < pEnd && *pChr != ' ' && *pChr != ',')
+		pChr++;
+	
+	// walk attributes once up to display name
+	while (pChr < pEnd)
 	{
-		// start substring at end of marker
-		iMarkerStart += strlen(strMarker);
-
-		// find the end of the content
-		if (iMarkerStart < (int)strLine.length())
+		// skip white space
+		if (*pChr == ' ' || *pChr == '\t')
 		{
-			// assume the character to look for is a space
-			char cFind = ' ';
-
-			// if marker has quote then look for next quote
-			if (strLine[iMarkerStart] == '"')
-			{
-				cFind = '"';
-				iMarkerStart++;
-			}
-
-			// look for end marker
-			iMarkerEnd = (int)strLine.find(cFind, iMarkerStart);
-
-			// if could not find marker then set to end
-			if (iMarkerEnd < 0)
-			{
-				iMarkerEnd = strLine.length();
-			}
+			pChr++;
+			continue;
+		}
+		
+		// display name follows first comma outside quotes
+		if (*pChr == ',')
+		{
+			pChr++;
+			break;
 		}
+		
+		// read marker up to and including equal sign
+		const char* pMarker = pChr;
+		
+		while (pChr < pEnd && *pChr != '=' && *pChr != ' ' && *pChr != ',')
+			pChr++;
+		
+		// skip words without value
+		if (pChr == pEnd || *pChr != '=')
+			continue;
+		
+		size_t iMarker = ++pChr - pMarker;
+		
+		// read value (quoted up to next quote, otherwise up to white space or comma)
+		M3UValue m3uValue;
+		
+		if (pChr < pEnd && *pChr == '"')
+		{
+			m3uValue.pStart = ++pChr;
+			
+			while (pChr < pEnd && *pChr != '"')
+				pChr++;
+			
+			m3uValue.iLength = pChr - m3uValue.pStart;
+			
+			if (pChr < pEnd)
+				pChr++;
+		}
+		else
+		{
+			m3uValue.pStart = pChr;
+			
+			while (pChr < pEnd && *pChr != ' ' && *pChr != ',' && *pChr != '\r')
+				pChr++;
+			
+			m3uValue.iLength = pChr - m3uValue.pStart;
+		}
+		
+		// keep known attributes
+		if      (iMarker == strlen(TVG_INFO_ID_MARKER   ) && !memcmp(pMarker, TVG_INFO_ID_MARKER   , iMarker)) m3uInfo.strTvgId     = m3uValue;
+		else if (iMarker == strlen(TVG_INFO_NAME_MARKER ) && !memcmp(pMarker, TVG_INFO_NAME_MARKER , iMarker)) m3uInfo.strTvgName   = m3uValue;
+		else if (iMarker == strlen(TVG_INFO_LOGO_MARKER ) && !memcmp(pMarker, TVG_INFO_LOGO_MARKER , iMarker)) m3uInfo.strTvgLogo   = m3uValue;
+		else if (iMarker == strlen(TVG_INFO_SHIFT_MARKER) && !memcmp(pMarker, TVG_INFO_SHIFT_MARKER, iMarker)) m3uInfo.strTvgShift  = m3uValue;
+		else if (iMarker == strlen(TVG_INFO_CHNO_MARKER ) && !memcmp(pMarker, TVG_INFO_CHNO_MARKER , iMarker)) m3uInfo.strTvgChNo   = m3uValue;
+		else if (iMarker == strlen(M3U_GROUP_NAME_MARKER) && !memcmp(pMarker, M3U_GROUP_NAME_MARKER, iMarker)) m3uInfo.strGroupName = m3uValue;
+		else if (iMarker == strlen(M3U_RADIO_MARKER     ) && !memcmp(pMarker, M3U_RADIO_MARKER     , iMarker)) m3uInfo.bIsRadio     = m3uValue;
+		else if (iMarker == strlen(M3U_HIDDEN_MARKER    ) && !memcmp(pMarker, M3U_HIDDEN_MARKER    , iMarker)) m3uInfo.bIsHidden    = m3uValue;
 	}
-
-	// return value if found otherwise return default
-	return (iMarkerStart >= 0 && iMarkerStart < (int)strLine.length()) ?  strLine.substr(iMarkerStart, iMarkerEnd - iMarkerStart) : string(strDefault);
+	
+	// trim display name
+	while (pChr < pEnd && isspace((unsigned char)*pChr))
+		pChr++;
+	
+	while (pEnd > pChr && isspace((unsigned char)*(pEnd-1)))
+		pEnd--;
+	
+	// keep display name
+	m3uInfo.strName.pStart  = pChr       ;
+	m3uInfo.strName.iLength = pEnd - pChr;
+	
+	// return info line
+	return true;
 }
 
-/***********************************************************
- * Line Function Definitions
- ***********************************************************/
-string GetDisplayName(const string& strM3ULine)
+string GetM3UValue(const M3UValue& m3uValue, const char* strDefault /*= ""*/)
 {
-  // get localized string
-  size_t iFound       = 0;
-  string strChannelName  = strM3ULine;
-  
-  // parse through string
-  while (iFound != string::npos)
-  {
-	// subset string
-	strChannelName = strChannelName.substr(iFound+1, strChannelName.length());
-	
-	// look for delimeter
-	iFound = strChannelName.find(",", (int)iFound);
-  }	
-  
-  // return file name
-  return StringUtils_Trim(strChannelName);
+	// return value if present otherwise return default
+	return (m3uValue.pStart && m3uValue.iLength) ? string(m3uValue.pStart, m3uValue.iLength) : string(strDefault);
 }
\ No newline at end of file
@@ -45,11 +45,27 @@ using namespace std;
 #define M3U_HIDDEN_MARKER          "hidden="
 
 /***********************************************************
- * Parse Function Definitions
+ * Token Definitions
  ***********************************************************/
-string ReadM3UMarkerValue(const string&, const char*, const char* = "");
+struct M3UValue{
+		const char* pStart ;
+		size_t      iLength;
+};
+
+struct M3UInfo{
+		M3UValue strTvgId    ;
+		M3UValue strTvgName  ;
+		M3UValue strTvgLogo  ;
+		M3UValue strTvgShift ;
+		M3UValue strTvgChNo  ;
+		M3UValue strGroupName;
+		M3UValue bIsRadio    ;
+		M3UValue bIsHidden   ;
+		M3UValue strName     ;
+};
 
 /***********************************************************
- * Line Function Definitions
+ * Parse Function Definitions
  ***********************************************************/
-string GetDisplayName(const string&);
\ No newline at end of file
+bool   ParseM3UInfo(const string&  , M3UInfo&      );
+string GetM3UValue (const M3UValue&, const char* = "");
\ No newline at end of file
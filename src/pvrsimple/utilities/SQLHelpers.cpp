@@ -35,7 +35,7 @@ string ParseSQLValue(const string& strValue, const char* strMarker, const char*
 	iMarkerEnd = (int)strValue.find("<", iMarkerStart);
 	
 	// return value if found otherwise return empty
-	return (strValue.find(strMarker) != string::npos) ?  strValue.substr(iMarkerStart, iMarkerEnd - iMarkerStart) : string(strDefault);
+	return (strValue.find(strMarker) != string::npos) ?  UnescapeSQLValue(strValue.substr(iMarkerStart, iMarkerEnd - iMarkerStart)) : string(strDefault);
 }
 
 string ParseSQLValue(const string& strValue, const char* strMarker, const int iDefault /* = 0 */)
@@ -48,7 +48,7 @@ string ParseSQLValue(const string& strValue, const char* strMarker, const int iD
 	iMarkerEnd = (int)strValue.find("<", iMarkerStart);
 	
 	// return value if found otherwise return empty
-	return (strValue.find(strMarker) != string::npos) ?  strValue.substr(iMarkerStart, iMarkerEnd - iMarkerStart) : itos(iDefault);
+	return (strValue.find(strMarker) != string::npos) ?  UnescapeSQLValue(strValue.substr(iMarkerStart, iMarkerEnd - iMarkerStart)) : itos(iDefault);
 }
 
 string ParseSQLValue(const string& strValue, const char* strMarker, const bool bDefault /* = false */)
@@ -61,5 +61,59 @@ string ParseSQLValue(const string& strValue, const char* strMarker, const bool b
 	iMarkerEnd = (int)strValue.find("<", iMarkerStart);
 	
 	// return value if found otherwise return empty
-	return (strValue.find(strMarker) != string::npos) ?  strValue.substr(iMarkerStart, iMarkerEnd - iMarkerStart) : btos(bDefault);
+	return (strValue.find(strMarker) != string::npos) ?  UnescapeSQLValue(strValue.substr(iMarkerStart, iMarkerEnd - iMarkerStart)) : btos(bDefault);
+}
+
+/***********************************************************
+ * Escape Function Definitions
+ ***********************************************************/
+string EscapeSQLValue(const string& strValue)
+{
+	// skip copy if nothing to escape
+	if (strValue.find_first_of("&<\r\n") == string::npos)
+		return strValue;
+	
+	// create container for escaped value
+	string strEscaped;
+	strEscaped.reserve(strValue.size() + 16);
+	
+	// replace markup and record separators
+	for (string::const_iterator c = strValue.begin(); c != strValue.end(); c++)
+	{
+		switch (*c)
+		{
+			case '&' : strEscaped += "&amp;" ; break;
+			case '<' : strEscaped += "&lt;"  ; break;
+			case '\r': strEscaped += "&#13;" ; break;
+			case '\n': strEscaped += "&#10;" ; break;
+			default  : strEscaped += *c      ; break;
+		}
+	}
+	
+	// return escaped value
+	return strEscaped;
+}
+
+string UnescapeSQLValue(const string& strValue)
+{
+	// skip copy if nothing to unescape
+	if (strValue.find('&') == string::npos)
+		return strValue;
+	
+	// create container for unescaped value
+	string strUnescaped;
+	strUnescaped.reserve(strValue.size());
+	
+	// replace escaped markup and record separators
+	for (size_t i = 0; i < strValue.size(); i++)
+	{
+		if      (strValue.compare(i, 5, "&amp;") == 0) {strUnescaped += '&' ; i += 4;}
+		else if (strValue.compare(i, 4, "&lt;" ) == 0) {strUnescaped += '<' ; i += 3;}
+		else if (strValue.compare(i, 5, "&#13;") == 0) {strUnescaped += '\r'; i += 4;}
+		else if (strValue.compare(i, 5, "&#10;") == 0) {strUnescaped += '\n'; i += 4;}
+		else                                            strUnescaped += strValue[i]  ;
+	}
+	
+	// return unescaped value
+	return strUnescaped;
 }
\ No newline at end of file
@@ -33,4 +33,10 @@ using namespace std;
  ***********************************************************/
 string ParseSQLValue(const string&, const char*, const char* =    "");
 string ParseSQLValue(const string&, const char*, const int   =     0);
-string ParseSQLValue(const string&, const char*, const bool  = false);
\ No newline at end of file
+string ParseSQLValue(const string&, const char*, const bool  = false);
+
+/***********************************************************
+ * Escape Function Definitions
+ ***********************************************************/
+string EscapeSQLValue  (const string&);
+string UnescapeSQLValue(const string&);
\ No newline at end of file
@@ -253,24 +253,22 @@ unsigned int ParseWeekDay (const time_t dtm)
 	                                           PVR_WEEKDAY_THURSDAY | PVR_WEEKDAY_FRIDAY  | PVR_WEEKDAY_SATURDAY  |
 	                                           PVR_WEEKDAY_SUNDAY   ;
 												 
-	// create output and string containers
+	// create output container
 	unsigned int ret;
 	tm * ptm;
-	char day[32];  
 	  
 	// parse day
 	ptm = localtime(&dtm);
-	strftime(day, 32, "%A", ptm); 
 	  
-	// assign value
-	if      (string(day) == "Monday"   ) ret = PVR_WEEKDAY_MONDAY   ;
-	else if (string(day) == "Tuesday"  ) ret = PVR_WEEKDAY_TUESDAY  ;
-	else if (string(day) == "Wednesday") ret = PVR_WEEKDAY_WEDNESDAY;
-	else if (string(day) == "Thursday" ) ret = PVR_WEEKDAY_THURSDAY ;
-	else if (string(day) == "Friday"   ) ret = PVR_WEEKDAY_FRIDAY   ;
-	else if (string(day) == "Saturday" ) ret = PVR_WEEKDAY_SATURDAY ;
-	else if (string(day) == "Sunday"   ) ret = PVR_WEEKDAY_SUNDAY   ;
-	else                                 ret = PVR_WEEKDAY_NONE     ;
+	// assign value (numeric weekday, no formatting or locale names)
+	if      (ptm->tm_wday == 1) ret = PVR_WEEKDAY_MONDAY   ;
+	else if (ptm->tm_wday == 2) ret = PVR_WEEKDAY_TUESDAY  ;
+	else if (ptm->tm_wday == 3) ret = PVR_WEEKDAY_WEDNESDAY;
+	else if (ptm->tm_wday == 4) ret = PVR_WEEKDAY_THURSDAY ;
+	else if (ptm->tm_wday == 5) ret = PVR_WEEKDAY_FRIDAY   ;
+	else if (ptm->tm_wday == 6) ret = PVR_WEEKDAY_SATURDAY ;
+	else if (ptm->tm_wday == 0) ret = PVR_WEEKDAY_SUNDAY   ;
+	else                        ret = PVR_WEEKDAY_NONE     ;
 	  
 	// return value
 	return ret;
@@ -290,6 +288,38 @@ string ParseTime (const time_t dtm)
   return string(tm);
 }
 
+int ParseSeconds (const time_t dtm)
+{
+	// create output container
+	tm * ptm;
+	
+	// parse time of day
+	ptm = localtime(&dtm);
+	
+	// return value (seconds since local midnight)
+	return ptm->tm_hour*3600 + ptm->tm_min*60 + ptm->tm_sec;
+}
+
+/***********************************************************
+ * URL Functions
+ ***********************************************************/
+string ParseHost (const string& url)
+{
+	// skip past scheme and credentials if given
+	size_t iStart = url.find("://");
+	
+	iStart = (iStart == string::npos) ? 0 : iStart + 3;
+	
+	size_t iEnd = url.find_first_of("/?#", iStart);
+	size_t iUser = url.rfind('@', iEnd);
+	
+	if (iUser != string::npos && iUser >= iStart)
+		iStart = iUser + 1;
+	
+	// return value (host and port)
+	return url.substr(iStart, iEnd == string::npos ? string::npos : iEnd - iStart);
+}
+
  /***********************************************************
 * BETA Definitions (Deprecated BETA is Over)
 ***********************************************************/
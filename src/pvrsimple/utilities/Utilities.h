@@ -25,6 +25,7 @@
 #include <ctime>
 #include <cstdarg>
 #include <vector>
+#include <map>
 #include <mutex>
 #include <iomanip>
 #include <cmath>
@@ -119,6 +120,12 @@ extern "C" char* strptime(const char* buf, const char* format, struct tm* tm);
  ***********************************************************/
 unsigned int ParseWeekDay (const time_t);
 string       ParseTime    (const time_t);
+int          ParseSeconds (const time_t);
+
+/***********************************************************
+ * URL Functions
+ ***********************************************************/
+string ParseHost(const string&);
  
  /***********************************************************
  * BETA Definitions
@@ -146,6 +146,45 @@ string GetXMLNodeValueAttr(const xml_node<> *pRootNode, const char* strTag, cons
 	return (pChildNode == NULL) ? string(strDefault) : strNodeValue;
 }
 
+/***********************************************************
+ * Parse Helper Definitions
+ ***********************************************************/
+static int ReadXMLDigits(const char* strText, const int iDigits)
+{
+	// create container
+	int iValue = 0;
+	
+	// read fixed number of digits (-1 if any is not a digit)
+	for (int i = 0; i < iDigits; i++)
+	{
+		if (strText[i] < '0' || strText[i] > '9')
+			return -1;
+		
+		iValue = (iValue * 10) + (strText[i] - '0');
+	}
+	
+	// return value
+	return iValue;
+}
+
+static long long GetXMLCivilDays(const int iYear, const int iMonth, const int iDay)
+{
+	// create cumulative days before month (march based year, leap day last)
+	static const int iMonthDays[12] = {306, 337, 0, 31, 61, 92, 122, 153, 184, 214, 245, 275};
+	
+	// shift year so it starts in march
+	long long year = iYear - (iMonth <= 2 ? 1 : 0);
+	
+	// split into 400 year eras
+	long long era = (year >= 0 ? year : year - 399) / 400;
+	long long yoe = year - (era * 400);
+	long long doy = iMonthDays[iMonth - 1] + iDay - 1;
+	long long doe = (yoe * 365) + (yoe / 4) - (yoe / 100) + doy;
+	
+	// return days since 1970-01-01
+	return (era * 146097) + doe - 719468;
+}
+
 /***********************************************************
  * Parse Function Definitions
  ***********************************************************/
@@ -164,31 +203,51 @@ int ParseXMLYear(const string& strDate)
 
 time_t ParseXMLDate(const string& strDateTm)
 {
+	// create cache of local midnights (few distinct dates per guide, one cache per decode worker)
+	static thread_local map<int, time_t> cDates;
+	
 	// create container
 	time_t date = 0;
 	  
 	// check appropriate length
 	if (strDateTm.length() == 8)
 	{
+		// read fixed position fields
+		int year = ReadXMLDigits(strDateTm.c_str()    , 4);
+		int mon  = ReadXMLDigits(strDateTm.c_str() + 4, 2);
+		int mday = ReadXMLDigits(strDateTm.c_str() + 6, 2);
+		
+		// return if not a date
+		if (year < 0 || mon < 0 || mday < 0)
+			return date;
+		
+		// look for date in cache
+		int iKey = (year * 10000) + (mon * 100) + mday;
+		
+		map<int, time_t>::iterator cDate = cDates.find(iKey);
+		
+		if (cDate != cDates.end())
+			return cDate->second;
+		
 		// create time container
 		struct tm time;
 		memset(&time, 0, sizeof(tm));
-			
-		// create time zone adjustors
-		char tz_sign = '+';
-		int  tz_hour =  0 ;
-		int  tz_min  =  0 ;
-			
-		// parse time string
-		sscanf(strDateTm.c_str(), "%04d%02d%02d", &time.tm_year, &time.tm_mon, &time.tm_mday);
-			
+		
 		// adjust read time
-		time.tm_mon  -=    1;
-		time.tm_year -= 1900;
-		time.tm_isdst =   -1;
+		time.tm_year  = year - 1900;
+		time.tm_mon   = mon  -    1;
+		time.tm_mday  = mday       ;
+		time.tm_isdst =         -1 ;
 			
-		// set date
+		// set date (local time zone only looked up once per date)
 		date = mktime(&time);
+		
+		// keep cache small
+		if (cDates.size() >= XMLTV_DATE_CACHE_SIZE)
+			cDates.clear();
+		
+		// add to cache
+		cDates[iKey] = date;
 	}
 	  
 	// return container
@@ -252,45 +311,31 @@ time_t ParseXMLDateTime(const string& strDateTm)
 	// create container
 	time_t datetm = time(NULL);
 	  
-	// check appropriate length
+	// check appropriate length (YYYYMMDDhhmmss +hhmm)
 	if (strDateTm.length() == 20)
 	{
-		// create time container
-		struct tm time;
-		memset(&time, 0, sizeof(tm));
-
-		// create time zone adjustors
-		char tz_sign = '+';
-		int  tz_hour =  0 ;
-		int  tz_min  =  0 ;
-
-		// parse time string
-		sscanf(strDateTm.c_str(), "%04d%02d%02d%02d%02d%02d %c%02d%02d", &time.tm_year, &time.tm_mon, &time.tm_mday, &time.tm_hour, &time.tm_min, &time.tm_sec, &tz_sign, &tz_hour, &tz_min);
-
-		// adjust read time
-		time.tm_mon  -=    1;
-		time.tm_year -= 1900;
-		time.tm_isdst =   -1;
-
-		// create local offset times
-		time_t     current_time ;
-		std::time(&current_time);
-		long       lt_offset    ;
-
-		// get machin local time
-		#ifndef TARGET_WINDOWS
-			lt_offset = -localtime(&current_time)->tm_gmtoff;
-		#else
-			TIME_ZONE_INFORMATION tz;
-			DWORD rc = ::GetTimeZoneInformation(&tz);
-			lt_offset = (tz.Bias + (TIME_ZONE_ID_DAYLIGHT != rc ?  tz.StandardBias : tz.DaylightBias))*60;
-		#endif // TARGET_WINDOWS
-
+		// read fixed position fields
+		const char* strText = strDateTm.c_str();
+		
+		int  year    = ReadXMLDigits(strText     , 4);
+		int  mon     = ReadXMLDigits(strText +  4, 2);
+		int  mday    = ReadXMLDigits(strText +  6, 2);
+		int  hour    = ReadXMLDigits(strText +  8, 2);
+		int  min     = ReadXMLDigits(strText + 10, 2);
+		int  sec     = ReadXMLDigits(strText + 12, 2);
+		char tz_sign =               strText[15]     ;
+		int  tz_hour = ReadXMLDigits(strText + 16, 2);
+		int  tz_min  = ReadXMLDigits(strText + 18, 2);
+		
+		// return if not a time stamp
+		if (year < 0 || mon < 1 || mon > 12 || mday < 1 || hour < 0 || min < 0 || sec < 0 || tz_hour < 0 || tz_min < 0 || (tz_sign != '+' && tz_sign != '-'))
+			return datetm;
+		
 		// get time zone offset from epg
 		long tz_offset = (tz_sign == '-' ? -1 : 1)*((tz_hour * 60 * 60) + (tz_min * 60));
 
-		// set time
-		datetm = mktime(&time) - tz_offset - lt_offset;
+		// set time (utc from calendar, no local time zone lookup)
+		datetm = (time_t)(GetXMLCivilDays(year, mon, mday) * 86400) + (hour * 60 * 60) + (min * 60) + sec - tz_offset;
 	}
 	  
 	// return container
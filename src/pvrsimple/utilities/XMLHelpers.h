@@ -59,6 +59,8 @@ using namespace rapidxml;
 #define XMLTV_STAR_RATING_MARKER   "star-rating"
 #define XMLTV_STAR_RATING_VALUE    "value"
 
+#define XMLTV_DATE_CACHE_SIZE      4096
+
 static const float STAR_RATING_SCALE = 10.0f;
 
 /***********************************************************
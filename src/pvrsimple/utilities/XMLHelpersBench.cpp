@@ -0,0 +1,229 @@
+﻿/*
+ *  pvr.sql - A PVR client for Kodi using M3U, XMLTV, and FFMPEG
+ *  Copyright © 2018 El_Gonz87 (Gonzalo Vega)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/***********************************************************
+ * Benchmark for XMLTV date parsing (not part of the addon)
+ *
+ * Build with -DSQL_BENCHMARKS=ON and run under the time
+ * zones of interest, e.g.:
+ *   TZ=UTC              ./xmlhelpers-bench
+ *   TZ=Europe/Madrid    ./xmlhelpers-bench
+ *   TZ=America/New_York ./xmlhelpers-bench
+ ***********************************************************/
+
+/***********************************************************
+ * Headers
+ ***********************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "XMLHelpers.h"
+
+/***********************************************************
+ * Benchmark Constants
+ ***********************************************************/
+#define BENCH_SAMPLES 200000
+#define BENCH_ROUNDS  3
+
+/***********************************************************
+ * Previous Parse Definitions (sscanf and mktime)
+ ***********************************************************/
+static time_t OldParseXMLDate(const string& strDateTm)
+{
+	// create container
+	time_t date = 0;
+	  
+	// check appropriate length
+	if (strDateTm.length() == 8)
+	{
+		// create time container
+		struct tm time;
+		memset(&time, 0, sizeof(tm));
+			
+		// parse time string
+		sscanf(strDateTm.c_str(), "%04d%02d%02d", &time.tm_year, &time.tm_mon, &time.tm_mday);
+			
+		// adjust read time
+		time.tm_mon  -=    1;
+		time.tm_year -= 1900;
+		time.tm_isdst =   -1;
+			
+		// set date
+		date = mktime(&time);
+	}
+	  
+	// return container
+	return date;
+}
+
+static time_t OldParseXMLDateTime(const string& strDateTm)
+{
+	// create container
+	time_t datetm = time(NULL);
+	  
+	// check appropriate length
+	if (strDateTm.length() == 20)
+	{
+		// create time container
+		struct tm time;
+		memset(&time, 0, sizeof(tm));
+
+		// create time zone adjustors
+		char tz_sign = '+';
+		int  tz_hour =  0 ;
+		int  tz_min  =  0 ;
+
+		// parse time string
+		sscanf(strDateTm.c_str(), "%04d%02d%02d%02d%02d%02d %c%02d%02d", &time.tm_year, &time.tm_mon, &time.tm_mday, &time.tm_hour, &time.tm_min, &time.tm_sec, &tz_sign, &tz_hour, &tz_min);
+
+		// adjust read time
+		time.tm_mon  -=    1;
+		time.tm_year -= 1900;
+		time.tm_isdst =   -1;
+
+		// create local offset times
+		time_t     current_time ;
+		std::time(&current_time);
+		long       lt_offset    ;
+
+		// get machine local time
+		#ifndef TARGET_WINDOWS
+			struct tm local_time;
+			lt_offset = -localtime_r(&current_time, &local_time)->tm_gmtoff;
+		#else
+			TIME_ZONE_INFORMATION tz;
+			DWORD rc = ::GetTimeZoneInformation(&tz);
+			lt_offset = (tz.Bias + (TIME_ZONE_ID_DAYLIGHT != rc ?  tz.StandardBias : tz.DaylightBias))*60;
+		#endif // TARGET_WINDOWS
+
+		// get time zone offset from epg
+		long tz_offset = (tz_sign == '-' ? -1 : 1)*((tz_hour * 60 * 60) + (tz_min * 60));
+
+		// set time
+		datetm = mktime(&time) - tz_offset - lt_offset;
+	}
+	  
+	// return container
+	return datetm;
+}
+
+/***********************************************************
+ * Reference Definitions
+ ***********************************************************/
+static time_t GetUTCTime(struct tm* time)
+{
+	// convert calendar time as utc
+	#ifndef TARGET_WINDOWS
+		return timegm(time);
+	#else
+		return _mkgmtime(time);
+	#endif // TARGET_WINDOWS
+}
+
+/***********************************************************
+ * Main Definitions
+ ***********************************************************/
+int main(void)
+{
+	// create sample containers (guide-like spread of dates, times and offsets)
+	static const char* strZones[] = {"+0000", "+0100", "-0500", "+0530", "+0200"};
+	
+	vector<string> strDateTms;
+	vector<string> strDates  ;
+	char           strBuffer[64];
+	
+	for (int i = 0; i < BENCH_SAMPLES; i++)
+	{
+		snprintf(strBuffer, sizeof(strBuffer), "%04d%02d%02d%02d%02d%02d %s", 1969 + (i % 80), 1 + (i % 12), 1 + (i % 28), i % 24, (i * 7) % 60, i % 60, strZones[i % 5]);
+		strDateTms.push_back(strBuffer);
+		
+		snprintf(strBuffer, sizeof(strBuffer), "%04d%02d%02d", 2018 + (i % 3), 1 + (i % 12), 1 + (i % 28));
+		strDates.push_back(strBuffer);
+	}
+	
+	// create check counters
+	long iBadDateTm = 0;
+	long iBadDate   = 0;
+	long iOldHour   = 0;
+	
+	// check new parse against timegm, and date parse against previous parse
+	for (size_t i = 0; i < strDateTms.size(); i++)
+	{
+		// read expected utc time
+		struct tm time;
+		memset(&time, 0, sizeof(tm));
+		
+		int  tz_hour = 0  ;
+		int  tz_min  = 0  ;
+		char tz_sign = '+';
+		
+		sscanf(strDateTms[i].c_str(), "%04d%02d%02d%02d%02d%02d %c%02d%02d", &time.tm_year, &time.tm_mon, &time.tm_mday, &time.tm_hour, &time.tm_min, &time.tm_sec, &tz_sign, &tz_hour, &tz_min);
+		
+		time.tm_mon  -=    1;
+		time.tm_year -= 1900;
+		
+		time_t tExpected = GetUTCTime(&time) - (tz_sign == '-' ? -1 : 1)*((tz_hour * 60 * 60) + (tz_min * 60));
+		time_t tNew      = ParseXMLDateTime   (strDateTms[i]);
+		time_t tOld      = OldParseXMLDateTime(strDateTms[i]);
+		
+		// count mismatches
+		if (tNew != tExpected)
+			iBadDateTm++;
+		
+		if (tOld != tNew && labs((long)(tOld - tNew)) == 3600)
+			iOldHour++;
+		
+		if (ParseXMLDate(strDates[i]) != OldParseXMLDate(strDates[i]))
+			iBadDate++;
+	}
+	
+	// print checks
+	printf("ParseXMLDateTime != timegm      : %ld of %zu\n", iBadDateTm, strDateTms.size());
+	printf("ParseXMLDate     != previous    : %ld of %zu\n", iBadDate  , strDates.size  ());
+	printf("previous off by one hour (DST)  : %ld of %zu\n", iOldHour  , strDateTms.size());
+	
+	// time both paths (first round warms caches)
+	for (int iRound = 0; iRound < BENCH_ROUNDS; iRound++)
+	{
+		// create sum so calls are not optimised out
+		long long iSum = 0;
+		
+		chrono::steady_clock::time_point tStart = chrono::steady_clock::now();
+		
+		for (size_t i = 0; i < strDateTms.size(); i++)
+			iSum += OldParseXMLDateTime(strDateTms[i]) + OldParseXMLDate(strDates[i]);
+		
+		chrono::steady_clock::time_point tMiddle = chrono::steady_clock::now();
+		
+		for (size_t i = 0; i < strDateTms.size(); i++)
+			iSum += ParseXMLDateTime(strDateTms[i]) + ParseXMLDate(strDates[i]);
+		
+		chrono::steady_clock::time_point tEnd = chrono::steady_clock::now();
+		
+		// print ns per date time and date pair
+		double fOld = chrono::duration<double, nano>(tMiddle - tStart ).count() / strDateTms.size();
+		double fNew = chrono::duration<double, nano>(tEnd    - tMiddle).count() / strDateTms.size();
+		
+		printf("round %i: previous %.0f ns  new %.0f ns  per pair (%.1fx) [%lld]\n", iRound + 1, fOld, fNew, fOld / fNew, iSum & 1);
+	}
+	
+	// return failure if new parse is wrong
+	return (iBadDateTm || iBadDate) ? 1 : 0;
+}
@@ -0,0 +1,289 @@
+﻿/*
+ *  pvr.sql - A PVR client for Kodi using M3U, XMLTV, and FFMPEG
+ *  Copyright © 2018 El_Gonz87 (Gonzalo Vega)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/***********************************************************
+ * Headers
+ ***********************************************************/
+#include "XMLReader.h"
+
+/***********************************************************
+ * Constructor/Destructor Definitions
+ ***********************************************************/
+XMLReader::XMLReader(void)
+{
+	// nothing open at start
+	iBufferPos = 0    ;
+	bEndOfFile = true ;
+	bIsValid   = false;
+	bIsParsed  = false;
+	pNode      = NULL ;
+}
+
+XMLReader::~XMLReader(void)
+{
+	// release file
+	Close();
+}
+
+/***********************************************************
+ * Open/Close Definitions
+ ***********************************************************/
+bool XMLReader::Open(const char* strPath)
+{
+	// release previous file
+	Close();
+	
+	// open the file (archives inflate as blocks are read)
+	if (!gzReader.Open(strPath))
+		return false;
+	
+	// create read block
+	strBlock.resize(XMLTV_READ_SIZE);
+	bEndOfFile = false;
+	
+	// return status
+	return true;
+}
+
+void XMLReader::Close(void)
+{
+	// close file
+	gzReader.Close();
+	
+	// clear source
+	bEndOfFile = true;
+	bIsValid   = false;
+	bIsParsed  = false;
+	pNode      = NULL;
+	
+	// drop buffered text
+	strName.clear();
+	strBuffer.clear();
+	strBlock.clear();
+	strElement.clear();
+	xmlElement.clear();
+	iBufferPos = 0;
+}
+
+/***********************************************************
+ * Fetch Element Definitions
+ ***********************************************************/
+bool XMLReader::Next(void)
+{
+	// drop previous element
+	bIsParsed = false;
+	pNode     = NULL ;
+	
+	// scan markup until a full channel or programme element is buffered
+	while (true)
+	{
+		// look for next tag
+		iBufferPos = strBuffer.find('<', iBufferPos);
+		
+		// read more if none (text between elements is dropped)
+		if (iBufferPos == string::npos)
+		{
+			iBufferPos = strBuffer.size();
+			
+			if (!ReadBlock())
+				return false;
+			
+			continue;
+		}
+		
+		// look for end of markup
+		size_t iTagEnd = FindEnd(iBufferPos);
+		
+		// read more if markup is cut by block
+		if (iTagEnd == string::npos)
+		{
+			if (!ReadBlock())
+				return false;
+			
+			continue;
+		}
+		
+		// skip comments, declarations, and closing tags
+		if (strBuffer[iBufferPos + 1] == '!' || strBuffer[iBufferPos + 1] == '?' || strBuffer[iBufferPos + 1] == '/')
+		{
+			iBufferPos = iTagEnd;
+			continue;
+		}
+		
+		// get element name
+		size_t iNameEnd = strBuffer.find_first_of(" \t\r\n/>", iBufferPos + 1);
+		strName         = strBuffer.substr(iBufferPos + 1, iNameEnd - iBufferPos - 1);
+		
+		// root only opens document (children are read one by one)
+		if (strName == XMLTV_START_MARKER)
+		{
+			bIsValid   = true;
+			iBufferPos = iTagEnd;
+			continue;
+		}
+		
+		// look for end of element (self closed or closing tag)
+		size_t iElementEnd = iTagEnd;
+		
+		if (strBuffer[iTagEnd - 2] != '/')
+		{
+			iElementEnd = strBuffer.find("</" + strName, iTagEnd);
+			iElementEnd = (iElementEnd != string::npos) ? FindEnd(iElementEnd) : string::npos;
+		}
+		
+		// read more if element is cut by block
+		if (iElementEnd == string::npos)
+		{
+			if (!ReadBlock())
+				return false;
+			
+			continue;
+		}
+		
+		// skip anything outside root or not a channel or programme
+		if (!bIsValid || (strName != XMLTV_CHANNEL_MARKER && strName != XMLTV_PROGRAM_MARKER))
+		{
+			iBufferPos = iElementEnd;
+			continue;
+		}
+		
+		// copy element for in place parse
+		strElement.assign(strBuffer.begin() + iBufferPos, strBuffer.begin() + iElementEnd);
+		strElement.push_back('\0');
+		
+		// move past element
+		iBufferPos = iElementEnd;
+		
+		// return element
+		return true;
+	}
+}
+
+const string& XMLReader::GetName(void) const
+{
+	// return current element name
+	return strName;
+}
+
+string XMLReader::GetElement(void) const
+{
+	// return current element text (for parsing elsewhere)
+	return strElement.empty() ? string() : string(&strElement[0], strElement.size() - 1);
+}
+
+const xml_node<>* XMLReader::GetNode(void)
+{
+	// return current element if already parsed
+	if (bIsParsed)
+		return pNode;
+	
+	// parse once per element
+	bIsParsed = true;
+	
+	// parse element alone (memory held is one element)
+	try
+	{
+		xmlElement.clear();
+		xmlElement.parse<0>(&strElement[0]);
+	}
+	catch (parse_error err)
+	{
+		// log issue and skip element
+		XBMC->Log(LOG_ERROR, "C+: %s - Failed to parse XMLTV %s, %s", __FUNCTION__, strName.c_str(), err.what());
+		return NULL;
+	}
+	
+	// get element node
+	pNode = xmlElement.first_node();
+	
+	// return element
+	return pNode;
+}
+
+bool XMLReader::IsValid(void) const
+{
+	// return if root was found
+	return bIsValid;
+}
+
+int XMLReader::GetStatus(void) const
+{
+	// return zlib status (not ok if archive was cut short or corrupt)
+	return gzReader.GetStatus();
+}
+
+/***********************************************************
+ * Stream Definitions
+ ***********************************************************/
+bool XMLReader::ReadBlock(void)
+{
+	// nothing left to read
+	if (bEndOfFile)
+		return false;
+	
+	// drop text already read (keeps buffer to one block plus a partial element)
+	strBuffer.erase(0, iBufferPos);
+	iBufferPos = 0;
+	
+	// read next block
+	int iBytes = gzReader.Read(&strBlock[0], XMLTV_READ_SIZE);
+	
+	// mark end of file
+	if (iBytes <= 0)
+	{
+		bEndOfFile = true;
+		return false;
+	}
+	
+	// add block to buffer
+	strBuffer.append(&strBlock[0], iBytes);
+	
+	// return status
+	return true;
+}
+
+size_t XMLReader::FindEnd(const size_t iStart)
+{
+	// comments end on their own marker
+	if (strBuffer.compare(iStart, 4, "<!--") == 0)
+	{
+		size_t iEnd = strBuffer.find("-->", iStart + 4);
+		return (iEnd != string::npos) ? iEnd + 3 : string::npos;
+	}
+	
+	// create container for open quote
+	char cQuote = 0;
+	
+	// look for closing bracket outside of quoted values
+	for (size_t i = iStart + 1; i < strBuffer.size(); i++)
+	{
+		if (cQuote)
+		{
+			if (strBuffer[i] == cQuote)
+				cQuote = 0;
+		}
+		else if (strBuffer[i] == '"' || strBuffer[i] == '\'')
+			cQuote = strBuffer[i];
+		else if (strBuffer[i] == '>')
+			return i + 1;
+	}
+	
+	// return not found
+	return string::npos;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+/*
+ *  pvr.sql - A PVR client for Kodi using M3U, XMLTV, and FFMPEG
+ *  Copyright © 2018 El_Gonz87 (Gonzalo Vega)
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Affero General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Affero General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Affero General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/***********************************************************
+ * Headers
+ ***********************************************************/
+#include "Callbacks.h"
+#include "GZHelpers.h"
+#include "XMLHelpers.h"
+
+/***********************************************************
+ * Namespace Definitions
+ ***********************************************************/
+using namespace std;
+using namespace rapidxml;
+
+/***********************************************************
+ * Define Constants
+ ***********************************************************/
+#define XMLTV_READ_SIZE 65536
+
+/***********************************************************
+ * Class Definitions
+ ***********************************************************/
+class XMLReader
+{
+	/* constructors/destrctors */
+	public:
+		 XMLReader(void);
+		~XMLReader(void);
+		
+	/* no copies (reader owns a gzip reader) */
+	private:
+		           XMLReader(const XMLReader&);
+		XMLReader& operator=(const XMLReader&);
+		
+	/* open/close api calls */
+	public:
+		bool Open (const char*);
+		void Close(void       );
+		
+	/* forward only fetch api calls (one channel or programme element at a time, parsed on first node request) */
+	public:
+		bool              Next      (void      );
+		const string&     GetName   (void) const;
+		string            GetElement(void) const;
+		const xml_node<>* GetNode   (void      );
+		bool              IsValid   (void) const;
+		int               GetStatus (void) const;
+		
+	/* stream functions */
+	private:
+		bool   ReadBlock(void        );
+		size_t FindEnd  (const size_t);
+		
+	/* source variables */
+	private:
+		GzipReader gzReader;
+		string     strBlock;
+		
+	/* element variables */
+	private:
+		string         strBuffer ;
+		size_t         iBufferPos;
+		bool           bEndOfFile;
+		bool           bIsValid  ;
+		string         strName   ;
+		vector<char>   strElement;
+		bool           bIsParsed ;
+		xml_document<> xmlElement;
+		xml_node<>    *pNode     ;
+};
\ No newline at end of file